@@ -5,36 +5,49 @@ clear
 # Create build directory if it doesn't exist
 mkdir -p build
 
+# Target: fm_synth (default, single render), bank_render (every preset of every bank),
+# benchmark (DSP and full-synth timings) or golden (reference renders: record / check)
+# Extra arguments are passed to the program
+TARGET=${1:-fm_synth}
+[ $# -gt 0 ] && shift
+
 # List all source files
-SOURCES="
-src/pc/main_pc.cpp
-"
+case $TARGET in
+    fm_synth)    SOURCES="src/pc/main_pc.cpp" ;;
+    bank_render) SOURCES="src/pc/bank_render.cpp" ;;
+    benchmark)   SOURCES="src/pc/benchmark.cpp" ;;
+    golden)      SOURCES="src/pc/golden.cpp" ;;
+    *)           echo "Unknown target: $TARGET (fm_synth, bank_render, benchmark, golden)"; exit 1 ;;
+esac
 
 # Maximum optimization flags for execution speed
-CXXFLAGS="-std=c++11 -O3 -march=native -ffast-math -flto"
+CXXFLAGS="-std=c++17 -O3 -march=native -ffast-math -flto"
 CXXFLAGS+=" -fno-exceptions -fno-rtti -fomit-frame-pointer"
-CXXFLAGS+=" -funroll-loops -ftree-vectorize"
+CXXFLAGS+=" -funroll-loops -ftree-vectorize -pthread"
 
 # Warning flags for code quality
 CXXFLAGS+=" -Wall -Wextra -Wpedantic -Wshadow"
 CXXFLAGS+=" -Wconversion -Wnull-dereference -Wlogical-op"
 CXXFLAGS+=" -Wduplicated-cond -Wduplicated-branches"
 
+# Integer (Q24) render engine instead of float, uncomment:
+# CXXFLAGS+=" -DFIXED_POINT_ENGINE"
+
 # For ARM microcontrollers (Teensy), uncomment:
 # CXXFLAGS+=" -mcpu=cortex-m7 -mfloat-abi=hard -mfpu=fpv5-d16"
 # CXXFLAGS+=" -D__ARM_ARCH"
 
 # Compile with g++
-g++ $CXXFLAGS -o build/fm_synth $SOURCES -I./src -lm
+g++ $CXXFLAGS -o build/$TARGET $SOURCES -I./src -lm
 
 # Check compilation result
 if [ $? -eq 0 ]; then
     echo "Compilation successful"
-    echo "Executable size: $(wc -c < build/fm_synth) bytes"
+    echo "Executable size: $(wc -c < build/$TARGET) bytes"
     echo "Launching program..."
     
     # Run the program
-    ./build/fm_synth
+    ./build/$TARGET "$@"
 else
     echo "Compilation failed"
     exit 1
@@ -2,15 +2,17 @@
 #define ALGORITHM_H
 
 #include "operator.h"
+#include "algorithm_kernels.h"
 #include "config.h"
 #include <array>
 
 // FM algorithm: routes 6 operators with modulation matrix
+// Rendering goes through a kernel specialised for the algorithm, picked in setConfig()
 class Algorithm {
 private:
     std::array<Operator*, NUM_OPERATORS> operators = {nullptr};
-    float modulationBuffer[NUM_OPERATORS] = {0.0f};
     const AlgorithmConfig* config = nullptr;
+    AlgorithmKernels::LaneKernel laneKernel = AlgorithmKernels::renderGeneric;
     
 public:
     bool addOperator(Operator* op) {
@@ -25,15 +27,9 @@ public:
     
     void setConfig(const AlgorithmConfig* algConfig) {
         config = algConfig;
+        laneKernel = AlgorithmKernels::select(algConfig);
     }
     
-    void setFeedback(uint8_t feedbackValue) {
-        if (!config) return;
-        if (config->hasFeedback && config->feedbackOperator < NUM_OPERATORS) {
-            operators[config->feedbackOperator]->setFeedback(feedbackValue);
-        }
-    }
-
     void triggerAll(uint8_t midiNote, uint8_t velocity = 100) {
         for (size_t i = 0; i < NUM_OPERATORS; ++i) {
             if (operators[i]) operators[i]->trigger(midiNote, velocity);
@@ -49,52 +45,15 @@ public:
     void resetAll() {
         for (size_t i = 0; i < NUM_OPERATORS; ++i) {
             if (operators[i]) operators[i]->reset();
-            modulationBuffer[i] = 0.0f;
         }
     }
     
-    // Process one sample - optimized hot path
-    inline float process(float pitchMod, float ampMod) {
-        if (!config) return 0.0f;
-
-        float finalOutput = 0.0f;
-
-        // Clear modulation buffer
-        modulationBuffer[0] = 0.0f;
-        modulationBuffer[1] = 0.0f;
-        modulationBuffer[2] = 0.0f;
-        modulationBuffer[3] = 0.0f;
-        modulationBuffer[4] = 0.0f;
-        modulationBuffer[5] = 0.0f;
-
-        // Process from highest to lowest index (5 to 0)
-        for (int i = NUM_OPERATORS - 1; i >= 0; --i) {
-            Operator* op = operators[i];
-            if (!op) continue;
-
-            // Accumulate phase modulation from modulators
-            float phaseMod = 0.0f;
-            const int modCount = config->modulatorCount[i];
-            for (int j = 0; j < modCount; ++j) {
-                phaseMod += modulationBuffer[config->modulatorIndices[i][j]];
-            }
-            phaseMod *= MODULATION_SCALING;
-
-            float output;
-            if (config->hasFeedback && i == config->feedbackOperator) {
-                output = op->processWithFeedback(pitchMod, ampMod) * OPERATOR_SCALING;
-            } else {
-                output = op->process(phaseMod, pitchMod, ampMod) * OPERATOR_SCALING;
-            }
-
-            modulationBuffer[i] = output;
-
-            if (config->isCarrier[i]) {
-                finalOutput += output;
-            }
-        }
-
-        return finalOutput;
+    // Render voices in lanes [begin, end) through this algorithm - SoA hot path
+    // Voices must have prepared their lanes (pitch modulation, gain ramps) for this block
+    // Voice outputs are written to lanes.output
+    inline void renderLanes(const VoiceConfig& voiceConfig, VoiceLanes& lanes, const LaneSample* ampMod,
+                            size_t begin, size_t end, size_t n) const {
+        laneKernel(voiceConfig, lanes, ampMod, begin, end, n);
     }
 };
 
@@ -0,0 +1,209 @@
+#ifndef ALGORITHM_KERNELS_H
+#define ALGORITHM_KERNELS_H
+
+#include "operator.h"
+#include "voice_lanes.h"
+#include "config.h"
+#include "connections.h"
+
+// Lane renderers for the algorithm routing
+// Each DX7 algorithm gets its own kernel with the routing resolved at compile time
+// (modulator sets, carriers, feedback operator), so rendering a block is straight-line
+// code over the six operators. Algorithm selects one from LANE_KERNELS when its config
+// is set; configs outside Algorithms::ALL_ALGORITHMS use the generic router
+namespace AlgorithmKernels {
+
+// Render voices in lanes [begin, end) through one algorithm into lanes.output
+// Voices must have prepared their lanes (pitch modulation, gain ramps) for this block
+typedef void (*LaneKernel)(const VoiceConfig& voiceConfig, VoiceLanes& lanes, const LaneSample* ampMod,
+                           size_t begin, size_t end, size_t n);
+
+static inline void clearLanes(LaneRow* buffer, size_t begin, size_t end, size_t n) {
+    for (size_t k = 0; k < n; ++k) {
+        for (size_t v = begin; v < end; ++v) buffer[k][v] = 0;
+    }
+}
+
+// Generic router: walks the modulator lists of voiceConfig.algorithm at run time
+// Operators are rendered from highest to lowest index so each modulator's block is
+// complete before its carriers read it (a lower-index modulator contributes nothing)
+static void renderGeneric(const VoiceConfig& voiceConfig, VoiceLanes& lanes, const LaneSample* ampMod,
+                          size_t begin, size_t end, size_t n) {
+    clearLanes(lanes.output, begin, end, n);
+    const AlgorithmConfig* cfg = voiceConfig.algorithm;
+    if (!cfg) return;
+
+    const int feedbackOperator = cfg->hasFeedback ? cfg->feedbackOperator : -1;
+
+    for (int i = NUM_OPERATORS - 1; i >= 0; --i) {
+        const OperatorConfig& opConfig = voiceConfig.operatorConfigs[i];
+        LaneRow* buffer = lanes.operatorOutput[i];
+        if (!opConfig.on) {
+            clearLanes(buffer, begin, end, n);
+            continue;
+        }
+
+        // Accumulate phase modulation from modulators already rendered this block
+        const LaneRow* phaseMod = nullptr;
+        const int modCount = cfg->modulatorCount[i];
+        for (int j = 0; j < modCount; ++j) {
+            const uint8_t modIndex = cfg->modulatorIndices[i][j];
+            if (static_cast<int>(modIndex) <= i) continue;
+
+            const LaneRow* modulator = lanes.operatorOutput[modIndex];
+            if (!phaseMod) {
+                for (size_t k = 0; k < n; ++k) {
+                    for (size_t v = begin; v < end; ++v) lanes.phaseMod[k][v] = modulator[k][v];
+                }
+                phaseMod = lanes.phaseMod;
+            } else {
+                for (size_t k = 0; k < n; ++k) {
+                    for (size_t v = begin; v < end; ++v) lanes.phaseMod[k][v] += modulator[k][v];
+                }
+            }
+        }
+
+        if (i == feedbackOperator) {
+            Operator::renderLanesWithFeedback(opConfig, lanes.operators[i], voiceConfig.feedback,
+                                              lanes.pitchMod, ampMod, buffer, begin, end, n);
+        } else {
+            Operator::renderLanes(opConfig, lanes.operators[i], phaseMod, lanes.pitchMod, ampMod,
+                                  buffer, begin, end, n);
+        }
+
+        if (cfg->isCarrier[i]) {
+            for (size_t k = 0; k < n; ++k) {
+                for (size_t v = begin; v < end; ++v) lanes.output[k][v] += buffer[k][v];
+            }
+        }
+    }
+}
+
+constexpr int lowestBit(unsigned mask, int bit = 0) {
+    return (bit >= static_cast<int>(NUM_OPERATORS)) ? 0 : (((mask >> bit) & 1u) ? bit : lowestBit(mask, bit + 1));
+}
+
+// Phase modulation input for modulator set MASK: nullptr if none, the modulator's own
+// buffer if there is one, otherwise the sum in ascending operator order (as listed)
+template<uint8_t MASK>
+static inline const LaneRow* modulation(VoiceLanes& lanes, size_t begin, size_t end, size_t n) {
+    if (MASK == 0) return nullptr;
+    if ((MASK & (MASK - 1)) == 0) return lanes.operatorOutput[lowestBit(MASK)];
+
+    const LaneRow* first = lanes.operatorOutput[lowestBit(MASK)];
+    for (size_t k = 0; k < n; ++k) {
+        for (size_t v = begin; v < end; ++v) lanes.phaseMod[k][v] = first[k][v];
+    }
+    for (int j = lowestBit(MASK) + 1; j < static_cast<int>(NUM_OPERATORS); ++j) {
+        if (!((MASK >> j) & 1u)) continue;
+        const LaneRow* modulator = lanes.operatorOutput[j];
+        for (size_t k = 0; k < n; ++k) {
+            for (size_t v = begin; v < end; ++v) lanes.phaseMod[k][v] += modulator[k][v];
+        }
+    }
+    return lanes.phaseMod;
+}
+
+// Operator OP of algorithm ALG (0-based), followed by the next lower operator
+template<size_t ALG, int OP>
+struct Stage {
+    static inline void render(const VoiceConfig& voiceConfig, VoiceLanes& lanes, const LaneSample* ampMod,
+                              size_t begin, size_t end, size_t n) {
+        constexpr uint8_t modulators = Algorithms::ALGORITHM_TOPOLOGY[ALG].modulatorMask[OP];
+        constexpr uint8_t carriers = Algorithms::ALGORITHM_TOPOLOGY[ALG].carrierMask;
+        constexpr bool isCarrier = ((carriers >> OP) & 1u) != 0;
+        constexpr bool firstCarrier = isCarrier && (carriers >> (OP + 1)) == 0;
+        constexpr bool hasFeedback = Algorithms::ALGORITHM_TOPOLOGY[ALG].feedbackOperator == OP;
+
+        const OperatorConfig& opConfig = voiceConfig.operatorConfigs[OP];
+        LaneRow* buffer = lanes.operatorOutput[OP];
+
+        if (!opConfig.on) {
+            clearLanes(buffer, begin, end, n);
+        } else if (hasFeedback) {
+            Operator::renderLanesWithFeedback(opConfig, lanes.operators[OP], voiceConfig.feedback,
+                                              lanes.pitchMod, ampMod, buffer, begin, end, n);
+        } else {
+            Operator::renderLanes(opConfig, lanes.operators[OP], modulation<modulators>(lanes, begin, end, n),
+                                  lanes.pitchMod, ampMod, buffer, begin, end, n);
+        }
+
+        // The highest carrier initialises the voice outputs, the others add to them
+        if (firstCarrier) {
+            for (size_t k = 0; k < n; ++k) {
+                for (size_t v = begin; v < end; ++v) lanes.output[k][v] = buffer[k][v];
+            }
+        } else if (isCarrier) {
+            for (size_t k = 0; k < n; ++k) {
+                for (size_t v = begin; v < end; ++v) lanes.output[k][v] += buffer[k][v];
+            }
+        }
+
+        Stage<ALG, OP - 1>::render(voiceConfig, lanes, ampMod, begin, end, n);
+    }
+};
+
+template<size_t ALG>
+struct Stage<ALG, -1> {
+    static inline void render(const VoiceConfig&, VoiceLanes&, const LaneSample*, size_t, size_t, size_t) {}
+};
+
+template<size_t ALG>
+static void renderAlgorithm(const VoiceConfig& voiceConfig, VoiceLanes& lanes, const LaneSample* ampMod,
+                            size_t begin, size_t end, size_t n) {
+    Stage<ALG, static_cast<int>(NUM_OPERATORS) - 1>::render(voiceConfig, lanes, ampMod, begin, end, n);
+}
+
+// Kernel of Algorithms::ALL_ALGORITHMS[i] at index i
+static const LaneKernel LANE_KERNELS[Algorithms::NUM_ALGORITHMS] = {
+    renderAlgorithm<0>,  renderAlgorithm<1>,  renderAlgorithm<2>,  renderAlgorithm<3>,
+    renderAlgorithm<4>,  renderAlgorithm<5>,  renderAlgorithm<6>,  renderAlgorithm<7>,
+    renderAlgorithm<8>,  renderAlgorithm<9>,  renderAlgorithm<10>, renderAlgorithm<11>,
+    renderAlgorithm<12>, renderAlgorithm<13>, renderAlgorithm<14>, renderAlgorithm<15>,
+    renderAlgorithm<16>, renderAlgorithm<17>, renderAlgorithm<18>, renderAlgorithm<19>,
+    renderAlgorithm<20>, renderAlgorithm<21>, renderAlgorithm<22>, renderAlgorithm<23>,
+    renderAlgorithm<24>, renderAlgorithm<25>, renderAlgorithm<26>, renderAlgorithm<27>,
+    renderAlgorithm<28>, renderAlgorithm<29>, renderAlgorithm<30>, renderAlgorithm<31>
+};
+
+// Specialised kernel for a predefined algorithm, generic router otherwise
+static inline LaneKernel select(const AlgorithmConfig* algConfig) {
+    for (size_t i = 0; i < Algorithms::NUM_ALGORITHMS; ++i) {
+        if (algConfig == Algorithms::ALL_ALGORITHMS[i]) return LANE_KERNELS[i];
+    }
+    return renderGeneric;
+}
+
+// Routing of algConfig as the generic router walks it, in ALGORITHM_TOPOLOGY form
+static inline Algorithms::AlgorithmTopology topologyOf(const AlgorithmConfig& algConfig) {
+    Algorithms::AlgorithmTopology topology = {};
+    for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+        for (size_t j = 0; j < algConfig.modulatorCount[i]; ++j) {
+            const uint8_t modIndex = algConfig.modulatorIndices[i][j];
+            if (modIndex > i) topology.modulatorMask[i] |= static_cast<uint8_t>(1u << modIndex);
+        }
+        if (algConfig.isCarrier[i]) topology.carrierMask |= static_cast<uint8_t>(1u << i);
+    }
+    topology.feedbackOperator = algConfig.hasFeedback ? static_cast<int8_t>(algConfig.feedbackOperator) : -1;
+    return topology;
+}
+
+// ALGORITHM_TOPOLOGY is kept by hand next to the configs it mirrors: index of the first
+// algorithm whose kernel would route differently from its config, -1 if all agree
+// (run by the golden and benchmark tools)
+static inline int findTopologyMismatch() {
+    for (size_t a = 0; a < Algorithms::NUM_ALGORITHMS; ++a) {
+        const Algorithms::AlgorithmTopology actual = topologyOf(*Algorithms::ALL_ALGORITHMS[a]);
+        const Algorithms::AlgorithmTopology& expected = Algorithms::ALGORITHM_TOPOLOGY[a];
+        bool same = actual.carrierMask == expected.carrierMask && actual.feedbackOperator == expected.feedbackOperator;
+        for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+            if (actual.modulatorMask[i] != expected.modulatorMask[i]) same = false;
+        }
+        if (!same) return static_cast<int>(a);
+    }
+    return -1;
+}
+
+} // namespace AlgorithmKernels
+
+#endif // ALGORITHM_KERNELS_H
@@ -1658,6 +1658,52 @@ static const AlgorithmConfig* ALL_ALGORITHMS[NUM_ALGORITHMS] = {
     &ALGORITHM_29, &ALGORITHM_30, &ALGORITHM_31, &ALGORITHM_32
 };
 
+// Compile-time routing of the 32 algorithms, used to build the specialised kernels
+// (algorithm_kernels.h). Mirrors the configs above as processed by the generic router:
+// a modulator only counts when its index is higher than its carrier's (rendered first),
+// so the OP4/OP5 -> OP6 loops of algorithms 4 and 6 carry no modulation
+// Edit both together: AlgorithmKernels::findTopologyMismatch() compares them
+struct AlgorithmTopology {
+    uint8_t modulatorMask[NUM_OPERATORS];  // Bit j set: OPj+1 modulates this operator
+    uint8_t carrierMask;                   // Bit i set: OPi+1 is a carrier
+    int8_t feedbackOperator;               // Operator with self-feedback, -1 if none
+};
+
+static constexpr AlgorithmTopology ALGORITHM_TOPOLOGY[NUM_ALGORITHMS] = {
+    { {0x02, 0x00, 0x08, 0x10, 0x20, 0x00}, 0x05,  5 },  // Algorithm 1
+    { {0x02, 0x00, 0x08, 0x10, 0x20, 0x00}, 0x05,  1 },  // Algorithm 2
+    { {0x02, 0x04, 0x00, 0x10, 0x20, 0x00}, 0x09,  5 },  // Algorithm 3
+    { {0x02, 0x04, 0x00, 0x10, 0x20, 0x00}, 0x09, -1 },  // Algorithm 4
+    { {0x02, 0x00, 0x08, 0x00, 0x20, 0x00}, 0x15,  5 },  // Algorithm 5
+    { {0x02, 0x00, 0x08, 0x00, 0x20, 0x00}, 0x15, -1 },  // Algorithm 6
+    { {0x02, 0x00, 0x18, 0x00, 0x20, 0x00}, 0x05,  5 },  // Algorithm 7
+    { {0x02, 0x00, 0x18, 0x00, 0x20, 0x00}, 0x05,  3 },  // Algorithm 8
+    { {0x02, 0x00, 0x18, 0x00, 0x20, 0x00}, 0x05,  1 },  // Algorithm 9
+    { {0x02, 0x04, 0x00, 0x30, 0x00, 0x00}, 0x09,  2 },  // Algorithm 10
+    { {0x02, 0x04, 0x00, 0x30, 0x00, 0x00}, 0x09,  5 },  // Algorithm 11
+    { {0x02, 0x00, 0x38, 0x00, 0x00, 0x00}, 0x05,  1 },  // Algorithm 12
+    { {0x02, 0x00, 0x38, 0x00, 0x00, 0x00}, 0x05,  5 },  // Algorithm 13
+    { {0x02, 0x00, 0x08, 0x30, 0x20, 0x00}, 0x05,  5 },  // Algorithm 14
+    { {0x02, 0x00, 0x08, 0x30, 0x20, 0x00}, 0x05,  1 },  // Algorithm 15
+    { {0x16, 0x00, 0x08, 0x00, 0x20, 0x00}, 0x01,  5 },  // Algorithm 16
+    { {0x16, 0x00, 0x08, 0x00, 0x20, 0x00}, 0x01,  1 },  // Algorithm 17
+    { {0x0E, 0x00, 0x00, 0x10, 0x20, 0x00}, 0x01,  2 },  // Algorithm 18
+    { {0x02, 0x04, 0x00, 0x20, 0x20, 0x00}, 0x19,  5 },  // Algorithm 19
+    { {0x04, 0x04, 0x00, 0x30, 0x00, 0x00}, 0x0B,  2 },  // Algorithm 20
+    { {0x04, 0x04, 0x00, 0x20, 0x20, 0x00}, 0x1B,  2 },  // Algorithm 21
+    { {0x02, 0x00, 0x20, 0x20, 0x20, 0x00}, 0x1D,  5 },  // Algorithm 22
+    { {0x00, 0x04, 0x00, 0x20, 0x20, 0x00}, 0x1B,  5 },  // Algorithm 23
+    { {0x00, 0x00, 0x20, 0x20, 0x20, 0x00}, 0x1F,  5 },  // Algorithm 24
+    { {0x00, 0x00, 0x00, 0x20, 0x20, 0x00}, 0x1F,  5 },  // Algorithm 25
+    { {0x00, 0x04, 0x00, 0x30, 0x00, 0x00}, 0x0B,  5 },  // Algorithm 26
+    { {0x00, 0x04, 0x00, 0x30, 0x00, 0x00}, 0x0B,  2 },  // Algorithm 27
+    { {0x02, 0x00, 0x08, 0x10, 0x00, 0x00}, 0x25,  4 },  // Algorithm 28
+    { {0x00, 0x00, 0x08, 0x00, 0x20, 0x00}, 0x17,  5 },  // Algorithm 29
+    { {0x00, 0x00, 0x08, 0x10, 0x00, 0x00}, 0x27,  4 },  // Algorithm 30
+    { {0x00, 0x00, 0x00, 0x00, 0x20, 0x00}, 0x1F,  5 },  // Algorithm 31
+    { {0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, 0x3F,  5 },  // Algorithm 32
+};
+
 } // namespace Algorithms
 
 #endif // CONNECTIONS_H
\ No newline at end of file
@@ -7,15 +7,39 @@
 // Audio
 constexpr float SAMPLE_RATE = 44100.0f;
 constexpr float INV_SAMPLE_RATE = 1.0f / SAMPLE_RATE;
+constexpr float PI_F = 3.14159265359f;
 constexpr float TWO_PI_F = 6.28318530718f; // 2*PI for oscillator phase calculations
 
 // Synth
+// Compile-time voice maximum (lane width): every lane array and snapshot table scales
+// with it. Teensy stays at 8 until the cost of 16 lanes is measured on the Cortex-M7
+#ifdef PLATFORM_TEENSY
 constexpr uint8_t POLYPHONY = 8;
+#else
+constexpr uint8_t POLYPHONY = 16;
+#endif
+constexpr uint8_t DEFAULT_VOICE_LIMIT = 8;  // Voices allowed at startup, adjusted by the governor
+constexpr uint8_t MIN_VOICE_LIMIT = 2;
+constexpr size_t EVENT_QUEUE_SIZE = 256;    // Pending control events (power of two)
+constexpr size_t NOTE_STACK_SIZE = 16;      // Held keys remembered in monophonic mode
+constexpr uint8_t UNISON_MAX_VOICES = 4;    // Voices stacked per key in unison mode
+constexpr float UNISON_MAX_DETUNE = 0.25f;  // Outer unison voices' offset at detune 99 (semitones)
 constexpr size_t NUM_OPERATORS = 6;
 constexpr float MODULATION_SCALING = 12.5f;
+constexpr size_t MAX_BLOCK_SIZE = 64; // Max samples per internal render block (larger requests are split)
+constexpr float RELEASE_CULL_DEFAULT_DB = -96.0f; // Released voices below this carrier gain (dBFS) are retired
+constexpr float RELEASE_CULL_OFF_DB = -144.0f;    // Thresholds at or below this disable release culling
+
+// Polyphony governor (audio CPU load in percent)
+constexpr float GOVERNOR_HIGH_LOAD = 85.0f;       // Above: shed voices now
+constexpr float GOVERNOR_LOW_LOAD = 60.0f;        // Below: room to raise the limit
+constexpr uint8_t GOVERNOR_RAISE_UPDATES = 10;    // Consecutive low readings per raised voice
+static_assert(MIN_VOICE_LIMIT <= DEFAULT_VOICE_LIMIT && DEFAULT_VOICE_LIMIT <= POLYPHONY, "Voice limits out of range");
 
 // LUT
 constexpr size_t OSC_LUT_SIZE = 4096;
+constexpr int OSC_LUT_BITS = 12;
+static_assert((1u << OSC_LUT_BITS) == OSC_LUT_SIZE, "OSC_LUT_BITS must match OSC_LUT_SIZE");
 constexpr float OSC_LUT_SIZE_F = static_cast<float>(OSC_LUT_SIZE);
 constexpr float INV_OSC_LUT_SIZE = 1.0f / OSC_LUT_SIZE_F;
 
@@ -27,6 +51,10 @@ constexpr float EXP2_LUT_MAX = 10.0f;
 constexpr float EXP2_LUT_RANGE = EXP2_LUT_MAX - EXP2_LUT_MIN;
 constexpr float EXP2_LUT_RANGE_INV = 1.0f / EXP2_LUT_RANGE;
 
+constexpr size_t TANH_LUT_SIZE = 1024;
+constexpr float TANH_LUT_RANGE = 5.0f;  // tanh(5) = 0.99991: saturated beyond
+constexpr float TANH_LUT_SCALE = static_cast<float>(TANH_LUT_SIZE) / (2.0f * TANH_LUT_RANGE);
+
 // Feedback
 constexpr uint8_t MAX_FEEDBACK_VALUE = 7;
 constexpr float FEEDBACK_TABLE[8] = {
@@ -37,6 +65,23 @@ constexpr float FEEDBACK_SCALING = 1.0f;
 // Operator
 constexpr float OPERATOR_SCALING = 0.125f;
 
+// Fixed-point engine (build with -DFIXED_POINT_ENGINE)
+// Samples and gains are Q24, a full oscillator cycle is 2^32 (uint32 phase wraps for free)
+constexpr float PHASE_CYCLE_F = 4294967296.0f;
+constexpr float Q24_ONE_F = 16777216.0f;
+constexpr uint32_t FIXED_MODULATION_SCALE = static_cast<uint32_t>(MODULATION_SCALING * 256.0f);  // Q24 sample -> phase
+constexpr int FIXED_OPERATOR_SHIFT = 3;  // OPERATOR_SCALING as a shift
+constexpr int FIXED_EXP2_BITS = 10;      // Integer exp2 table resolution (per octave)
+constexpr size_t FIXED_EXP2_SIZE = 1 << FIXED_EXP2_BITS;
+constexpr uint32_t FIXED_MAX_PHASE_INC = static_cast<uint32_t>(20000.0f * (PHASE_CYCLE_F * INV_SAMPLE_RATE));  // 20 kHz
+static_assert(MODULATION_SCALING * 256.0f == static_cast<float>(FIXED_MODULATION_SCALE), "Modulation scale must be exact in Q24");
+static_assert(OPERATOR_SCALING * (1 << FIXED_OPERATOR_SHIFT) == 1.0f, "Operator scaling must be a power of two");
+// 2^(s / 12) for s = 0..11 in Q30: 12-TET key increments without libm
+constexpr uint32_t SEMITONE_RATIO_Q30[12] = {
+    1073741824u, 1137589835u, 1205234447u, 1276901417u, 1352829926u, 1433273380u,
+    1518500250u, 1608794974u, 1704458901u, 1805811301u, 1913190429u, 2026954652u
+};
+
 // Keyboard level scaling curves
 constexpr uint8_t KEYSCALE_LINEAR[100] = {
     0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
@@ -83,7 +128,8 @@ constexpr float DETUNE_TABLE[15] = {
 constexpr uint32_t Q24_ONE = 1 << 24;
 constexpr float INV_Q24_ONE = 1.0f / static_cast<float>(Q24_ONE);
 constexpr int LG_N = 6;
-constexpr int N = (1 << LG_N);
+constexpr size_t N = (1 << LG_N); // Control-rate sub-block: envelopes advance once per N samples
+static_assert(MAX_BLOCK_SIZE <= N, "A render block must fit in one envelope sub-block");
 
 // Velocity sensitivity
 constexpr float VELOCITY_FACTOR_TABLE[8][9] = {
@@ -160,13 +206,37 @@ constexpr int8_t PITCHENV_TAB[100] = {
     82, 92, 103, 115, 127
 };
 
+// Effects chain
+// Delay lines are fixed arrays inside FxChain (no allocation); lengths in samples at 44.1 kHz
+constexpr size_t CHORUS_DELAY_SIZE = 1024;  // Power of two, 23 ms
+constexpr float CHORUS_BASE_DELAY = 7.0f * SAMPLE_RATE / 1000.0f;   // 7 ms centre
+constexpr float CHORUS_MAX_DEPTH = 5.0f * SAMPLE_RATE / 1000.0f;    // +-5 ms sweep at depth 99
+constexpr size_t REVERB_COMBS = 4;
+constexpr size_t REVERB_ALLPASSES = 2;
+constexpr size_t REVERB_COMB_LENGTHS[REVERB_COMBS] = {1116, 1188, 1277, 1356};  // Freeverb tunings
+constexpr size_t REVERB_ALLPASS_LENGTHS[REVERB_ALLPASSES] = {556, 441};
+constexpr size_t REVERB_BUFFER_SIZE = 1116 + 1188 + 1277 + 1356 + 556 + 441;
+constexpr size_t FILTER_CONTROL_BLOCK = 16;    // Samples per cutoff/resonance smoothing step
+constexpr float FILTER_SMOOTHING = 0.1f;       // Share of the remaining distance per step (~3.6 ms)
+constexpr float FILTER_SNAP = 1e-4f;           // Closer than this to the target: settled
+constexpr size_t FILTER_TAIL_SAMPLES = 4410;   // Resonance ring-out after the input went silent
+constexpr float FX_LOAD_SMOOTHING = 0.05f;  // Per-block weight of the stage load average
+constexpr float FX_TAIL_DB = 96.0f;         // Effect tails are rendered down to this attenuation
+
 // Parameters constants
 // Default file path for global parameters persistence
 // On Teensy, this would be on SD card; on PC, in current directory
 constexpr const char* PARAMS_FILE_PATH = "params.bin";
-constexpr uint8_t PARAMS_VERSION = 1;
+constexpr uint8_t PARAMS_VERSION = 3;          // 2: portamento, 3: unison (older files still load)
 constexpr uint32_t PARAMS_MAGIC = 0x47504152; // "GPAR"
 
+// Tuning constants
+// Scala scale and keyboard mapping loaded at startup when present (SD card / current directory)
+constexpr const char* TUNING_SCL_PATH = "tuning.scl";
+constexpr const char* TUNING_KBM_PATH = "tuning.kbm";
+constexpr size_t TUNING_FILE_MAX_SIZE = 4096;  // Bytes per .scl/.kbm file
+constexpr int TUNING_MAX_DEGREES = 128;        // Scale degrees / keyboard map entries
+
 // Inverse constants for parameter normalization
 constexpr float INV_PARAM_99 = 1.0f / 99.0f;
 constexpr float INV_PARAM_7 = 1.0f / 7.0f;
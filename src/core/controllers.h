@@ -0,0 +1,71 @@
+#ifndef CONTROLLERS_H
+#define CONTROLLERS_H
+
+#include <cmath>
+#include "constants.h"
+#include "params.h"
+#include "lfo.h"
+
+// Performance controllers (pitch bend, modulation wheel) as a control-rate stage
+// The event path stores the raw MIDI values; once per block update() turns them into
+// LFO modulation targets using Params (bend range, wheel intensity and assignment),
+// and the LFO ramps from the previous block's targets to the new ones. At rest (bend
+// centred, wheel down, ramps settled) the LFO runs its plain loop: no per-sample cost
+class Controllers {
+private:
+    uint16_t pitchBend = 8192;  // 14-bit, 8192 = centre
+    uint8_t modWheel = 0;       // CC#1
+    bool portamentoOn = true;   // CC#65 (on without a pedal: the time alone decides)
+
+    LFOModulation previous = {};  // Targets of the last block (where this block's ramp starts)
+    LFOModulation target = {};
+
+public:
+    Controllers() = default;
+
+    void setPitchBend(uint16_t value) { pitchBend = (value > 16383) ? 16383 : value; }
+    void setModWheel(uint8_t value) { modWheel = value & 0x7F; }
+    uint16_t getPitchBend() const { return pitchBend; }
+    uint8_t getModWheel() const { return modWheel; }
+    void setPortamentoSwitch(bool on) { portamentoOn = on; }
+    bool getPortamentoSwitch() const { return portamentoOn; }
+
+    // Bend to centre, wheel down, portamento switch back on (CC#121)
+    void reset() {
+        pitchBend = 8192;
+        modWheel = 0;
+        portamentoOn = true;
+    }
+
+    // Block start: new targets from the raw controllers
+    // Returns false at rest, when the block needs no controller processing
+    bool update(const Params& params) {
+        previous = target;
+
+        const int bend = static_cast<int>(pitchBend) - 8192;
+#ifdef FIXED_POINT_ENGINE
+        // Integer engine: bend in Q24 octaves, wheel in Q24
+        target.bend = static_cast<int32_t>((static_cast<int64_t>(bend) * params.pitchBendRange * Q24_ONE) / (8192 * 12));
+
+        const int32_t wheel = static_cast<int32_t>((static_cast<int64_t>(modWheel) * params.modWheelIntensity * Q24_ONE) / (127 * 99));
+        target.pitchDepth = params.modWheelAssignment.pitchModDepth ? wheel : 0;
+        target.ampDepth = params.modWheelAssignment.ampModDepth ? wheel : 0;
+        target.egBias = params.modWheelAssignment.egBias ? wheel : 0;
+#else
+        target.bend = (bend == 0) ? 1.0f
+                    : exp2f(static_cast<float>(bend) * (1.0f / 8192.0f) * static_cast<float>(params.pitchBendRange) * (1.0f / 12.0f));
+
+        const float wheel = static_cast<float>(modWheel) * (1.0f / 127.0f) * static_cast<float>(params.modWheelIntensity) * INV_PARAM_99;
+        target.pitchDepth = params.modWheelAssignment.pitchModDepth ? wheel : 0.0f;
+        target.ampDepth = params.modWheelAssignment.ampModDepth ? wheel : 0.0f;
+        target.egBias = params.modWheelAssignment.egBias ? wheel : 0.0f;
+#endif
+
+        return !(previous.isNeutral() && target.isNeutral());
+    }
+
+    const LFOModulation& getPrevious() const { return previous; }
+    const LFOModulation& getTarget() const { return target; }
+};
+
+#endif // CONTROLLERS_H
@@ -0,0 +1,44 @@
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include <cstdint>
+#include "constants.h"
+
+#ifdef PLATFORM_TEENSY
+    #include <Arduino.h>
+#else
+    #include <chrono>
+#endif
+
+// Cheap timestamp for measuring DSP stages inside the audio callback
+// Teensy: the Cortex-M7 cycle counter (DWT, enabled by the Teensy core)
+// PC: steady clock nanoseconds. Both wrap at 32 bits: only differences over
+// short intervals (a block) are meaningful
+namespace CycleCounter {
+    inline uint32_t now() {
+        #ifdef PLATFORM_TEENSY
+        return ARM_DWT_CYCCNT;
+        #else
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        #endif
+    }
+
+    // Ticks per second of now()
+    inline float ticksPerSecond() {
+        #ifdef PLATFORM_TEENSY
+        return static_cast<float>(F_CPU_ACTUAL);
+        #else
+        return 1e9f;
+        #endif
+    }
+
+    // Share of the real-time budget of n samples that ticks took, in percent
+    // (same scale as AudioProcessorUsage() on Teensy)
+    inline float loadPercent(uint32_t ticks, size_t n) {
+        return 100.0f * static_cast<float>(ticks) * SAMPLE_RATE /
+               (ticksPerSecond() * static_cast<float>(n));
+    }
+}
+
+#endif // CYCLE_COUNTER_H
@@ -0,0 +1,381 @@
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include "constants.h"
+#include "lut.h"
+#include "cycle_counter.h"
+#include "filter.h"
+
+// Post-synth effects: filter, drive, chorus and reverb, processed in place over whole blocks
+// Parameters (0-99, like the DX7 ones) are set from the control side; each stage
+// turns them into coefficients there and the audio side loads them once per block
+
+// Soft clipping: tanh(x * gain), scaled back so full scale stays full scale
+class Drive {
+private:
+    std::atomic<float> gain{1.0f};
+    std::atomic<float> makeup{1.0f};
+    std::atomic<float> mix{1.0f};
+
+public:
+    Drive() = default;
+
+    void set(uint8_t amount, uint8_t mixAmount) {
+        const float g = 1.0f + 19.0f * static_cast<float>((amount > 99) ? 99 : amount) * INV_PARAM_99;
+        gain.store(g, std::memory_order_relaxed);
+        makeup.store(1.0f / std::tanh(g), std::memory_order_relaxed);
+        mix.store(static_cast<float>((mixAmount > 99) ? 99 : mixAmount) * INV_PARAM_99, std::memory_order_relaxed);
+    }
+
+    void clear() {}
+    size_t getTailSamples() const { return 0; }
+
+    void process(float* buffer, size_t n) {
+        const float g = gain.load(std::memory_order_relaxed);
+        const float m = makeup.load(std::memory_order_relaxed);
+        const float wet = mix.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < n; ++i) {
+            const float x = buffer[i];
+            buffer[i] = x + wet * (LUT::tanh(x * g) * m - x);
+        }
+    }
+};
+
+// Single-tap chorus: a delay line swept by a sine LFO, mixed with the dry signal
+// Stereo runs one per side, their sweeps a quarter cycle apart
+class Chorus {
+private:
+    float delayLine[CHORUS_DELAY_SIZE];
+    size_t writeIndex = 0;
+    float phase = 0.0f;
+
+    std::atomic<float> phaseInc{0.0f};
+    std::atomic<float> depth{0.0f};  // Sweep in samples
+    std::atomic<float> mix{0.0f};
+
+public:
+    Chorus() { clear(); }
+
+    // rate 0-99: 0.1-5 Hz
+    void set(uint8_t rate, uint8_t depthAmount, uint8_t mixAmount) {
+        const float hz = 0.1f + 4.9f * static_cast<float>((rate > 99) ? 99 : rate) * INV_PARAM_99;
+        phaseInc.store(hz * INV_SAMPLE_RATE, std::memory_order_relaxed);
+        depth.store(CHORUS_MAX_DEPTH * static_cast<float>((depthAmount > 99) ? 99 : depthAmount) * INV_PARAM_99,
+                    std::memory_order_relaxed);
+        mix.store(static_cast<float>((mixAmount > 99) ? 99 : mixAmount) * INV_PARAM_99, std::memory_order_relaxed);
+    }
+
+    void clear() {
+        memset(delayLine, 0, sizeof(delayLine));
+        writeIndex = 0;
+    }
+
+    void setPhase(float sweepPhase) { phase = sweepPhase; }
+
+    size_t getTailSamples() const { return CHORUS_DELAY_SIZE; }
+
+    void process(float* buffer, size_t n) {
+        const float inc = phaseInc.load(std::memory_order_relaxed);
+        const float sweep = depth.load(std::memory_order_relaxed);
+        const float wet = mix.load(std::memory_order_relaxed);
+        constexpr size_t mask = CHORUS_DELAY_SIZE - 1;
+
+        for (size_t i = 0; i < n; ++i) {
+            const float x = buffer[i];
+            delayLine[writeIndex] = x;
+
+            // Fractional read position behind the write index
+            const float delay = CHORUS_BASE_DELAY + sweep * LUT::sin(phase);
+            const float position = static_cast<float>(writeIndex + CHORUS_DELAY_SIZE) - delay;
+            const size_t i0 = static_cast<size_t>(position);
+            const float frac = position - static_cast<float>(i0);
+            const float a = delayLine[i0 & mask];
+            const float b = delayLine[(i0 + 1) & mask];
+            const float delayed = a + frac * (b - a);
+
+            buffer[i] = x + wet * (delayed - x);
+            writeIndex = (writeIndex + 1) & mask;
+            phase += inc;
+            if (phase >= 1.0f) phase -= 1.0f;
+        }
+    }
+};
+
+// Mono Freeverb subset: parallel damped combs into series allpasses
+// Each filter runs over the whole block before the next (one delay line hot at a time)
+// In stereo the two sides feed it together and both receive its output
+class Reverb {
+private:
+    float storage[REVERB_BUFFER_SIZE];
+    float* combBuffer[REVERB_COMBS];
+    float* allpassBuffer[REVERB_ALLPASSES];
+    size_t combIndex[REVERB_COMBS] = {0};
+    size_t allpassIndex[REVERB_ALLPASSES] = {0};
+    float combFilter[REVERB_COMBS] = {0.0f};  // One-pole damping state
+
+    std::atomic<float> feedback{0.84f};
+    std::atomic<float> damping{0.2f};
+    std::atomic<float> mix{0.0f};
+    std::atomic<size_t> tailSamples{0};
+
+    static constexpr float INPUT_GAIN = 0.03f;  // Freeverb fixed gain for half the combs
+    static constexpr float WET_GAIN = 3.0f;
+    static constexpr float ALLPASS_FEEDBACK = 0.5f;
+
+public:
+    Reverb() {
+        float* next = storage;
+        for (size_t c = 0; c < REVERB_COMBS; ++c) {
+            combBuffer[c] = next;
+            next += REVERB_COMB_LENGTHS[c];
+        }
+        for (size_t a = 0; a < REVERB_ALLPASSES; ++a) {
+            allpassBuffer[a] = next;
+            next += REVERB_ALLPASS_LENGTHS[a];
+        }
+        clear();
+        set(50, 50, 0);
+    }
+
+    // Points into its own storage
+    Reverb(const Reverb&) = delete;
+    Reverb& operator=(const Reverb&) = delete;
+
+    void set(uint8_t size, uint8_t dampingAmount, uint8_t mixAmount) {
+        const float g = 0.7f + 0.28f * static_cast<float>((size > 99) ? 99 : size) * INV_PARAM_99;
+        feedback.store(g, std::memory_order_relaxed);
+        damping.store(0.4f * static_cast<float>((dampingAmount > 99) ? 99 : dampingAmount) * INV_PARAM_99,
+                      std::memory_order_relaxed);
+        mix.store(static_cast<float>((mixAmount > 99) ? 99 : mixAmount) * INV_PARAM_99, std::memory_order_relaxed);
+
+        // Passes through the longest comb until the tail is FX_TAIL_DB down
+        const float passes = FX_TAIL_DB / (-20.0f * std::log10(g));
+        tailSamples.store(static_cast<size_t>(passes * static_cast<float>(REVERB_COMB_LENGTHS[REVERB_COMBS - 1])),
+                          std::memory_order_relaxed);
+    }
+
+    void clear() {
+        memset(storage, 0, sizeof(storage));
+        for (size_t c = 0; c < REVERB_COMBS; ++c) {
+            combIndex[c] = 0;
+            combFilter[c] = 0.0f;
+        }
+        for (size_t a = 0; a < REVERB_ALLPASSES; ++a) allpassIndex[a] = 0;
+    }
+
+    size_t getTailSamples() const { return tailSamples.load(std::memory_order_relaxed); }
+
+    // right may be null (mono)
+    void process(float* left, float* right, size_t n) {
+        const float g = feedback.load(std::memory_order_relaxed);
+        const float damp = damping.load(std::memory_order_relaxed);
+        const float wet = mix.load(std::memory_order_relaxed);
+
+        float input[MAX_BLOCK_SIZE];
+        float reverb[MAX_BLOCK_SIZE];
+        while (n > 0) {
+            const size_t count = (n < MAX_BLOCK_SIZE) ? n : MAX_BLOCK_SIZE;
+            if (right) {
+                for (size_t i = 0; i < count; ++i) input[i] = (left[i] + right[i]) * (0.5f * INPUT_GAIN);
+            } else {
+                for (size_t i = 0; i < count; ++i) input[i] = left[i] * INPUT_GAIN;
+            }
+            for (size_t i = 0; i < count; ++i) reverb[i] = 0.0f;
+
+            for (size_t c = 0; c < REVERB_COMBS; ++c) {
+                float* line = combBuffer[c];
+                const size_t length = REVERB_COMB_LENGTHS[c];
+                size_t index = combIndex[c];
+                float filter = combFilter[c];
+                for (size_t i = 0; i < count; ++i) {
+                    const float y = line[index];
+                    filter = y + damp * (filter - y);
+                    line[index] = input[i] + filter * g;
+                    reverb[i] += y;
+                    if (++index == length) index = 0;
+                }
+                combIndex[c] = index;
+                combFilter[c] = filter;
+            }
+
+            for (size_t a = 0; a < REVERB_ALLPASSES; ++a) {
+                float* line = allpassBuffer[a];
+                const size_t length = REVERB_ALLPASS_LENGTHS[a];
+                size_t index = allpassIndex[a];
+                for (size_t i = 0; i < count; ++i) {
+                    const float delayed = line[index];
+                    line[index] = reverb[i] + delayed * ALLPASS_FEEDBACK;
+                    reverb[i] = delayed - reverb[i];
+                    if (++index == length) index = 0;
+                }
+                allpassIndex[a] = index;
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                left[i] += wet * (reverb[i] * WET_GAIN - left[i]);
+            }
+            if (right) {
+                for (size_t i = 0; i < count; ++i) {
+                    right[i] += wet * (reverb[i] * WET_GAIN - right[i]);
+                }
+                right += count;
+            }
+            left += count;
+            n -= count;
+        }
+    }
+};
+
+// Filter -> drive -> chorus -> reverb, each stage bypassable
+// A bypassed stage costs nothing: no call, no timing. The audio side picks up
+// enable changes at the next block and clears a stage's delay lines when it is
+// switched on. While the synth is silent the chain runs only as long as the
+// enabled stages' tails last, so idle blocks stay idle
+class FxChain {
+public:
+    enum Stage : uint8_t {
+        FILTER = 0,
+        DRIVE,
+        CHORUS,
+        REVERB,
+        STAGE_COUNT
+    };
+
+private:
+    ResonantFilter filter[2];  // Left (mono), right
+    Drive drive = {};          // Stateless: shared by both sides
+    Chorus chorus[2];
+    Reverb reverb;
+
+    std::atomic<uint8_t> enabledMask{0};  // Control side
+    uint8_t activeMask = 0;                // Audio side: stages running
+    size_t tailRemaining = 0;              // Samples of tail left after the input went silent
+    std::atomic<float> stageLoad[STAGE_COUNT];
+
+    // Run one stage over both sides (right null: mono) and time it
+    void runStage(Stage stage, float* left, float* right, size_t n) {
+        const uint32_t start = CycleCounter::now();
+        switch (stage) {
+            case FILTER:
+                filter[0].process(left, n);
+                if (right) filter[1].process(right, n);
+                break;
+            case DRIVE:
+                drive.process(left, n);
+                if (right) drive.process(right, n);
+                break;
+            case CHORUS:
+                chorus[0].process(left, n);
+                if (right) chorus[1].process(right, n);
+                break;
+            default:
+                reverb.process(left, right, n);
+                break;
+        }
+        const float load = CycleCounter::loadPercent(CycleCounter::now() - start, n);
+        const float previous = stageLoad[stage].load(std::memory_order_relaxed);
+        stageLoad[stage].store(previous + FX_LOAD_SMOOTHING * (load - previous), std::memory_order_relaxed);
+    }
+
+    size_t getTailSamples() const {
+        size_t tail = 0;
+        if (activeMask & (1u << FILTER)) tail += filter[0].getTailSamples();
+        if (activeMask & (1u << DRIVE)) tail += drive.getTailSamples();
+        if (activeMask & (1u << CHORUS)) tail += chorus[0].getTailSamples();
+        if (activeMask & (1u << REVERB)) tail += reverb.getTailSamples();
+        return tail;
+    }
+
+public:
+    FxChain() {
+        for (auto& load : stageLoad) load.store(0.0f, std::memory_order_relaxed);
+        chorus[1].setPhase(0.25f);
+    }
+
+    // Delay lines live inside the chain
+    FxChain(const FxChain&) = delete;
+    FxChain& operator=(const FxChain&) = delete;
+
+    // Control side
+    void setEnabled(Stage stage, bool enabled) {
+        const uint8_t bit = static_cast<uint8_t>(1u << stage);
+        if (enabled) enabledMask.fetch_or(bit, std::memory_order_relaxed);
+        else enabledMask.fetch_and(static_cast<uint8_t>(~bit), std::memory_order_relaxed);
+    }
+
+    bool isEnabled(Stage stage) const {
+        return (enabledMask.load(std::memory_order_relaxed) >> stage) & 1u;
+    }
+
+    void setFilter(uint8_t cutoff, uint8_t resonance, ResonantFilter::Mode mode = ResonantFilter::LOWPASS_24) {
+        for (auto& side : filter) side.set(cutoff, resonance, mode);
+    }
+    void setFilterGain(uint8_t gain) {
+        for (auto& side : filter) side.setGain(gain);
+    }
+    void setDrive(uint8_t amount, uint8_t mix) { drive.set(amount, mix); }
+    void setChorus(uint8_t rate, uint8_t depth, uint8_t mix) {
+        for (auto& side : chorus) side.set(rate, depth, mix);
+    }
+    void setReverb(uint8_t size, uint8_t damping, uint8_t mix) { reverb.set(size, damping, mix); }
+
+    // Smoothed cost of a stage, percent of the real-time budget (0 when bypassed)
+    float getStageLoad(Stage stage) const {
+        return stageLoad[stage].load(std::memory_order_relaxed);
+    }
+
+    // The same cost per blockSize samples in CycleCounter ticks (CPU cycles on Teensy, ns on PC)
+    float getStageTicks(Stage stage, size_t blockSize) const {
+        return getStageLoad(stage) * 0.01f * CycleCounter::ticksPerSecond() *
+               static_cast<float>(blockSize) * INV_SAMPLE_RATE;
+    }
+
+    float getLoad() const {
+        float total = 0.0f;
+        for (const auto& load : stageLoad) total += load.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // Audio side: process n samples in place, mono (right null) or planar stereo;
+    // inputActive is false when the synth rendered silence, which only lets the
+    // tails ring out
+    void process(float* left, float* right, size_t n, bool inputActive) {
+        const uint8_t requested = enabledMask.load(std::memory_order_relaxed);
+        if (requested != activeMask) {
+            const uint8_t switchedOn = requested & static_cast<uint8_t>(~activeMask);
+            if (switchedOn & (1u << FILTER)) {
+                for (auto& side : filter) side.clear();
+            }
+            if (switchedOn & (1u << CHORUS)) {
+                for (auto& side : chorus) side.clear();
+            }
+            if (switchedOn & (1u << REVERB)) reverb.clear();
+            for (uint8_t s = 0; s < STAGE_COUNT; ++s) {
+                if (!((requested >> s) & 1u)) stageLoad[s].store(0.0f, std::memory_order_relaxed);
+            }
+            activeMask = requested;
+            if (tailRemaining > getTailSamples()) tailRemaining = getTailSamples();
+        }
+
+        if (!activeMask) return;
+        if (inputActive) {
+            tailRemaining = getTailSamples();
+        } else if (tailRemaining == 0) {
+            return;  // Nothing left to ring out
+        } else {
+            tailRemaining = (tailRemaining > n) ? tailRemaining - n : 0;
+        }
+
+        for (uint8_t stage = 0; stage < STAGE_COUNT; ++stage) {
+            if ((activeMask >> stage) & 1u) runStage(static_cast<Stage>(stage), left, right, n);
+        }
+    }
+
+    // No tail left: a silent input gives a silent output (audio side)
+    bool isIdle() const { return tailRemaining == 0; }
+};
+
+#endif // EFFECTS_H
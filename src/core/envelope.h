@@ -102,6 +102,22 @@ public:
         goToState(4);
     }
 
+    // Switch to a new config without disturbing the running segment: levels and
+    // rates take effect from the next state change, the output level at once
+    void replaceConfig(const EnvelopeConfig* envConfig) {
+        initialised = true;
+        config = envConfig;
+        levels[0] = config->l1;
+        levels[1] = config->l2;
+        levels[2] = config->l3;
+        levels[3] = config->l4;
+        rates[0] = config->r1;
+        rates[1] = config->r2;
+        rates[2] = config->r3;
+        rates[3] = config->r4;
+        outputLevel = scaleOutLevel(config->outputLevel) << 5;
+    }
+
     void update(int rateScalingInput = 0) {
         if (!config) return;
         levels[0] = config->l1;
@@ -114,7 +130,8 @@ public:
         rates[3] = config->r4;
         outputLevel = scaleOutLevel(config->outputLevel) << 5;
         rateScaling = rateScalingInput;
-        goToState(currentState);
+        // A held note sustains in state 3: head back to the (new) L3 like Dexed does
+        goToState((keyDown && currentState == 3) ? 2 : currentState);
     }
     
     void setRateScaling(int rateScalingInput) {
@@ -126,49 +143,103 @@ public:
         keyDown = true;
         goToState(0);
     }
+
+    // Note-on with the key's rate scaling (one state setup instead of two)
+    void trigger(int rateScalingInput) {
+        rateScaling = rateScalingInput;
+        trigger();
+    }
     
     void release() {
         keyDown = false;
         if (currentState < 3) goToState(3);
     }
     
-    // Process one sample - optimized hot path
-    inline float process() {
-        if (!initialised) return 0.0f;
+    // Advance the state machine by count samples at once (control rate)
+    // Produces exactly the level/state of count per-sample steps: each call integrates
+    // whole slope segments and carries leftover samples across stage transitions
+    inline void advance(uint32_t count) {
+        if (!initialised) return;
         
-        // Handle static timing (equal level pause)
-        if (staticCount > 0) {
-            --staticCount;
-            if (staticCount == 0) goToState(currentState + 1);
-            return LUT::exp2(static_cast<float>(currentLevel) * INV_Q24_ONE - 14.0f);
-        }
+        while (count > 0) {
+            // Handle static timing (equal level pause)
+            if (staticCount > 0) {
+                if (static_cast<uint32_t>(staticCount) > count) {
+                    staticCount -= static_cast<int>(count);
+                    return;
+                }
+                count -= static_cast<uint32_t>(staticCount);
+                staticCount = 0;
+                goToState(currentState + 1);
+                continue;
+            }
 
-        // Process envelope stages
-        const bool shouldProcess = (currentState < 3) || (currentState == 3 && !keyDown);
-        
-        if (shouldProcess) {
+            // Process envelope stages
+            const bool shouldProcess = (currentState < 3) || (currentState == 3 && !keyDown);
+            if (!shouldProcess) return;
+
+            const uint32_t target = static_cast<uint32_t>(targetLevel);
+            uint32_t samples;  // Samples until the target is reached (inclusive)
+            
             if (rising) {
-                constexpr int jumptarget = 1716;
+                constexpr uint32_t jumptarget = 1716;
                 if (currentLevel < (jumptarget << 16)) {
                     currentLevel = jumptarget << 16;
                 }
-                currentLevel += (((17 << 24) - currentLevel) >> 24) * increment;
-                if (currentLevel >= static_cast<uint32_t>(targetLevel)) {
-                    currentLevel = targetLevel;
-                    goToState(currentState + 1);
+                
+                // The rise multiplier only changes when the level crosses a multiple of 2^24
+                const uint32_t multiplier = ((17u << 24) - currentLevel) >> 24;
+                const uint32_t slope = multiplier * static_cast<uint32_t>(increment);
+                // At 16 << 24 and above the multiplier is 0: the level stalls below a
+                // higher target (boosted output level), as in the per-sample rule
+                if (slope == 0) return;
+                const uint32_t boundary = (17u - multiplier) << 24;
+                const uint32_t segment = (boundary - currentLevel) / slope + 1;
+                
+                samples = (currentLevel >= target) ? 1 : (target - currentLevel + slope - 1) / slope;
+                if (samples > count || samples > segment) {
+                    const uint32_t steps = (count < segment) ? count : segment;
+                    currentLevel += steps * slope;
+                    count -= steps;
+                    continue;
                 }
             } else {
-                currentLevel -= increment;
-                if (currentLevel <= static_cast<uint32_t>(targetLevel)) {
-                    currentLevel = targetLevel;
-                    goToState(currentState + 1);
+                const uint32_t decrement = static_cast<uint32_t>(increment);
+                samples = (currentLevel <= target) ? 1 : (currentLevel - target + decrement - 1) / decrement;
+                if (samples > count) {
+                    currentLevel -= count * decrement;
+                    return;
                 }
             }
+
+            currentLevel = target;
+            count -= samples;
+            goToState(currentState + 1);
         }
+    }
 
+    
+    // Linear gain of the current level
+    inline float getGain() const {
+        if (!initialised) return 0.0f;
         return LUT::exp2(static_cast<float>(currentLevel) * INV_Q24_ONE - 14.0f);
     }
     
+#ifdef FIXED_POINT_ENGINE
+    // Linear gain of the current level in Q24 (integer engine)
+    inline int32_t getGainQ24() const {
+        if (!initialised) return 0;
+        return LUT::exp2Q24(static_cast<int32_t>(currentLevel) - (14 << 24));
+    }
+#endif
+    
+    // Process one sample (audio rate)
+    inline float process() {
+        advance(1);
+        return getGain();
+    }
+
+    
     void reset() {
         goToState(4);
         currentLevel = 0;
@@ -176,6 +247,9 @@ public:
     
     uint8_t getState() const { return currentState; }
 
+    // Level still climbing towards the current stage target
+    bool isRising() const { return currentState < 4 && rising; }
+
     bool isActive() const {
         return initialised && (currentState < 4 || (currentState == 4 && levels[3] > 0));
     }
@@ -0,0 +1,72 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <atomic>
+#include "constants.h"
+
+// Synth event stamped with the sample time at which it takes effect
+// Posted by the control side (MIDI, UI, sequencer), applied by the audio side
+struct SynthEvent {
+    enum Type : uint8_t {
+        NoteOn,         // data1 = note, data2 = velocity (0 = note off)
+        NoteOff,        // data1 = note
+        ControlChange,  // data1 = controller, data2 = value
+        PitchBend       // data2 = 14-bit value, 8192 = centre
+    };
+
+    uint32_t time = 0;  // Synth sample time (Synth::getSampleTime() clock)
+    Type type = NoteOn;
+    uint8_t data1 = 0;
+    uint16_t data2 = 0;
+
+    SynthEvent() = default;
+    SynthEvent(uint32_t eventTime, Type eventType, uint8_t first, uint16_t second)
+        : time(eventTime), type(eventType), data1(first), data2(second) {}
+};
+
+// Wait-free single-producer single-consumer ring
+// One thread (control loop) pushes, one thread (audio interrupt / render loop) peeks
+// and pops; each index is written by one side only, so no lock and no retry loop
+template<typename T, size_t CAPACITY>
+class EventQueue {
+private:
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Queue capacity must be a power of two");
+    static constexpr uint32_t MASK = static_cast<uint32_t>(CAPACITY - 1);
+
+    T slots[CAPACITY];
+    // Indices on separate 32-byte lines (Cortex-M7 cache line): no false sharing
+    alignas(32) std::atomic<uint32_t> head{0};  // Next slot to read (consumer)
+    alignas(32) std::atomic<uint32_t> tail{0};  // Next slot to write (producer)
+
+public:
+    EventQueue() = default;
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    // Producer: false if the queue is full (event dropped)
+    bool push(const T& item) {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == CAPACITY) return false;
+        slots[t & MASK] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: oldest event without removing it, nullptr if empty
+    const T* peek() const {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return nullptr;
+        return &slots[h & MASK];
+    }
+
+    // Consumer: drop the event returned by peek()
+    void pop() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif // EVENT_QUEUE_H
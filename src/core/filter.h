@@ -0,0 +1,185 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <atomic>
+#include <cmath>
+#include "constants.h"
+
+// 24 dB resonant multimode filter with DC blocking, from Dexed PluginFx (OB-Xd 4-pole)
+// Block-processing port for the effects chain:
+// - all-float state and coefficients (Teensy has a single-precision FPU; Dexed used double)
+// - cutoff and resonance glide toward their targets once per FILTER_CONTROL_BLOCK samples
+// - the tan() and resonance curves are recomputed only while a value is still moving,
+//   otherwise the cached coefficients are reused
+// - cutoff fully open and unity gain leave only the DC blocker, as in Dexed
+class ResonantFilter {
+public:
+    enum Mode : uint8_t {
+        LOWPASS_24 = 0,  // Dexed's mode: fourth pole
+        LOWPASS_12,      // Second pole
+        BANDPASS_12      // 2 * (first - second pole), the Xpander band-pass mix
+    };
+
+private:
+    // Ladder, pre-filter and DC blocker state
+    float s1 = 0.0f, s2 = 0.0f, s3 = 0.0f, s4 = 0.0f;
+    float highpassState = 0.0f;  // 15 Hz high-pass of the resonance input
+    float brightState = 0.0f;    // Near-Nyquist one-pole
+    float dcInput = 0.0f;
+    float dcOutput = 0.0f;
+
+    // Fixed coefficients (sample rate)
+    float highpassCoeff = 0.0f;
+    float brightCoeff = 0.0f;
+    float dcPole = 0.0f;
+    float damping = 0.0f;  // rcor24: soft limit of the first pole
+    float dampingInv = 0.0f;
+
+    // Control-rate values: current (smoothed) and cached coefficients
+    float cutoff = 1.0f;     // 0-1
+    float resonance = 0.0f;  // 0-1
+    float g = 0.0f;          // tan(pi * fc / fs)
+    float lpc = 0.0f;        // g / (1 + g)
+    float ml = 1.0f;         // 1 / (1 + g)
+    float r24 = 0.0f;        // Resonance feedback (0-3.5)
+    float compensation = 1.0f;
+    bool coefficientsValid = false;
+
+    std::atomic<float> targetCutoff{1.0f};
+    std::atomic<float> targetResonance{0.0f};
+    std::atomic<float> gain{1.0f};
+    std::atomic<uint8_t> mode{LOWPASS_24};
+
+    // Dexed logsc(): exponential map of 0-1 onto [min, max]
+    static float logScale(float param, float min, float max) {
+        constexpr float rolloff = 19.0f;
+        return ((expf(param * logf(rolloff + 1.0f)) - 1.0f) / rolloff) * (max - min) + min;
+    }
+
+    void updateCoefficients() {
+        const float rReso = 0.991f - logScale(1.0f - resonance, 0.0f, 0.991f);
+        r24 = 3.5f * rReso;
+        compensation = 1.0f + r24 * 0.45f;
+
+        g = tanf(logScale(cutoff, 60.0f, 19000.0f) * INV_SAMPLE_RATE * PI_F);
+        lpc = g / (1.0f + g);
+        ml = 1.0f / (1.0f + g);
+        coefficientsValid = true;
+    }
+
+    // Move cutoff and resonance one control step toward their targets
+    void smoothParameters() {
+        const float cutoffTarget = targetCutoff.load(std::memory_order_relaxed);
+        const float resonanceTarget = targetResonance.load(std::memory_order_relaxed);
+        if (cutoff == cutoffTarget && resonance == resonanceTarget && coefficientsValid) return;
+
+        cutoff += FILTER_SMOOTHING * (cutoffTarget - cutoff);
+        resonance += FILTER_SMOOTHING * (resonanceTarget - resonance);
+        if (fabsf(cutoffTarget - cutoff) < FILTER_SNAP) cutoff = cutoffTarget;
+        if (fabsf(resonanceTarget - resonance) < FILTER_SNAP) resonance = resonanceTarget;
+        updateCoefficients();
+    }
+
+    // One-pole TPT step (Dexed tptpc) with a precomputed k = cutoff / (1 + cutoff)
+    static inline float onePole(float& state, float input, float k) {
+        const float v = (input - state) * k;
+        const float output = v + state;
+        state = output + v;
+        return output;
+    }
+
+    void processLadder(float* buffer, size_t n, uint8_t filterMode) {
+        const float G = lpc * lpc * lpc * lpc;
+        const float feedbackNorm = 1.0f / (1.0f + r24 * G);
+
+        for (size_t i = 0; i < n; ++i) {
+            float s = buffer[i];
+            s -= 0.45f * onePole(highpassState, s, highpassCoeff);
+            s = onePole(brightState, s, brightCoeff);
+
+            // Zero-delay feedback solve (Dexed NR24)
+            const float S = (lpc * (lpc * (lpc * s1 + s2) + s3) + s4) * ml;
+            const float y0 = (s - r24 * S) * feedbackNorm + 1e-8f;
+
+            const float v = (y0 - s1) * lpc;
+            const float y1 = v + s1;
+            s1 = atanf((y1 + v) * damping) * dampingInv;  // Soft-limited first pole
+            const float y2 = onePole(s2, y1, lpc);
+            const float y3 = onePole(s3, y2, lpc);
+            const float y4 = onePole(s4, y3, lpc);
+
+            float out;
+            switch (filterMode) {
+                case LOWPASS_12: out = y2; break;
+                case BANDPASS_12: out = 2.0f * (y1 - y2); break;
+                default: out = y4; break;
+            }
+            buffer[i] = out * compensation;
+        }
+    }
+
+public:
+    ResonantFilter() {
+        const float highpass = 15.0f * INV_SAMPLE_RATE * PI_F;
+        highpassCoeff = highpass / (1.0f + highpass);
+        const float bright = tanf((SAMPLE_RATE * 0.5f - 10.0f) * PI_F * INV_SAMPLE_RATE);
+        brightCoeff = bright / (1.0f + bright);
+        dcPole = 1.0f - 126.0f * INV_SAMPLE_RATE;
+        damping = (970.0f / 44000.0f) * sqrtf(44000.0f * INV_SAMPLE_RATE);
+        dampingInv = 1.0f / damping;
+    }
+
+    // Control side: cutoff and resonance 0-99 (glide there), output gain 0-99 (99 = unity)
+    void set(uint8_t cutoffAmount, uint8_t resonanceAmount, Mode filterMode) {
+        targetCutoff.store(static_cast<float>((cutoffAmount > 99) ? 99 : cutoffAmount) * INV_PARAM_99,
+                           std::memory_order_relaxed);
+        targetResonance.store(static_cast<float>((resonanceAmount > 99) ? 99 : resonanceAmount) * INV_PARAM_99,
+                              std::memory_order_relaxed);
+        mode.store(filterMode, std::memory_order_relaxed);
+    }
+
+    void setGain(uint8_t gainAmount) {
+        gain.store((gainAmount >= 99) ? 1.0f : static_cast<float>(gainAmount) * INV_PARAM_99, std::memory_order_relaxed);
+    }
+
+    // Audio side: start from rest, parameters jump to their targets
+    void clear() {
+        s1 = s2 = s3 = s4 = 0.0f;
+        highpassState = brightState = 0.0f;
+        dcInput = dcOutput = 0.0f;
+        cutoff = targetCutoff.load(std::memory_order_relaxed);
+        resonance = targetResonance.load(std::memory_order_relaxed);
+        updateCoefficients();
+    }
+
+    size_t getTailSamples() const { return FILTER_TAIL_SAMPLES; }
+
+    void process(float* buffer, size_t n) {
+        // DC blocker
+        float input = dcInput;
+        float output = dcOutput;
+        for (size_t i = 0; i < n; ++i) {
+            const float x = buffer[i];
+            output = x - input + dcPole * output;
+            input = x;
+            buffer[i] = output;
+        }
+        dcInput = input;
+        dcOutput = output;
+
+        const float outputGain = gain.load(std::memory_order_relaxed);
+        if (outputGain != 1.0f) {
+            for (size_t i = 0; i < n; ++i) buffer[i] *= outputGain;
+        }
+
+        const uint8_t filterMode = mode.load(std::memory_order_relaxed);
+        for (size_t offset = 0; offset < n; offset += FILTER_CONTROL_BLOCK) {
+            smoothParameters();
+            if (cutoff >= 1.0f && filterMode != BANDPASS_12) continue;  // Fully open low-pass
+            const size_t count = (n - offset < FILTER_CONTROL_BLOCK) ? n - offset : FILTER_CONTROL_BLOCK;
+            processLadder(buffer + offset, count, filterMode);
+        }
+    }
+};
+
+#endif // FILTER_H
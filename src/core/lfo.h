@@ -4,59 +4,167 @@
 #include "constants.h"
 #include "config.h"
 #include "lut.h"
+#include "oscillator.h"
+
+#ifdef FIXED_POINT_ENGINE
+// Integer engine: the LFO runs on a uint32 phase and hands out Q24 values, pitch as
+// an offset in octaves (the voices add the pitch envelope and take one exp2)
+typedef int32_t LFOPitch;
+
+// Performance controller contribution to the LFO outputs (see Controllers), Q24
+struct LFOModulation {
+    int32_t bend = 0;        // Pitch bend in octaves
+    int32_t pitchDepth = 0;  // Mod wheel vibrato depth (0-1, like pitchModDepth / 99)
+    int32_t ampDepth = 0;    // Mod wheel tremolo depth (0-1, like ampModDepth / 99)
+    int32_t egBias = 0;      // Mod wheel EG bias: steady amp mod (0-1)
+
+    bool isNeutral() const {
+        return bend == 0 && pitchDepth == 0 && ampDepth == 0 && egBias == 0;
+    }
+};
+#else
+typedef float LFOPitch;  // Frequency ratio
+
+// Performance controller contribution to the LFO outputs (see Controllers)
+struct LFOModulation {
+    float bend = 1.0f;        // Pitch bend frequency ratio
+    float pitchDepth = 0.0f;  // Mod wheel vibrato depth (0-1, like pitchModDepth / 99)
+    float ampDepth = 0.0f;    // Mod wheel tremolo depth (0-1, like ampModDepth / 99)
+    float egBias = 0.0f;      // Mod wheel EG bias: steady amp mod (0-1)
+
+    bool isNeutral() const {
+        return bend == 1.0f && pitchDepth == 0.0f && ampDepth == 0.0f && egBias == 0.0f;
+    }
+};
+#endif
 
 // LFO with multiple waveforms for pitch and amplitude modulation
 class LFO {
 private:
     const LFOConfig* config = nullptr;
-    float phase = 0.0f;
-    float ampMod = 0.0f;
-    float pitchMod = 1.0f;
+    LanePhase phase = 0;
+    LaneSample ampMod = 0;
     int delaySamples = 0;
-    float sampleHoldValue = 0.0f;
+    LaneSample sampleHoldValue = 0;
+    
+    // Per-sample outputs of the last processBlock() call
+    LFOPitch pitchModBuffer[MAX_BLOCK_SIZE] = {0};
+    LaneSample ampModBuffer[MAX_BLOCK_SIZE] = {0};
     
     // Fast random (xorshift32)
     uint32_t randState = 12345;
     
-    inline float fastRandom() {
+#ifdef FIXED_POINT_ENGINE
+    LFOPitch pitchMod = 0;
+
+    // Q24 value in [-1, 1) from the generator's top bits
+    inline int32_t fastRandom() {
         randState ^= randState << 13;
         randState ^= randState >> 17;
         randState ^= randState << 5;
-        return static_cast<float>(randState) * 4.6566129e-10f * 2.0f - 1.0f;
+        return static_cast<int32_t>(randState >> 7) - static_cast<int32_t>(Q24_ONE);
     }
 
-public:
-    LFO() = default;
+    // Phase step of the configured speed (one rounding step from the table), per block
+    inline uint32_t phaseIncrement() const {
+        return static_cast<uint32_t>(static_cast<double>(LFO_SPEED[config->speed]) *
+                                     (4294967296.0 / static_cast<double>(SAMPLE_RATE)));
+    }
 
-    void configure(const LFOConfig* lfoConfig) {
-        config = lfoConfig;
+    // 0-99 parameter as a Q24 depth (0-1)
+    static inline int32_t depthQ24(uint8_t value) {
+        return static_cast<int32_t>((static_cast<uint32_t>(value) << 24) / 99);
     }
 
-    void trigger() {
-        phase = 0.0f;
-        ampMod = 0.0f;
-        pitchMod = 1.0f;
-        if (config) {
-            delaySamples = static_cast<int>(LFO_DELAY[config->delay] * SAMPLE_RATE);
+    // Pitch modulation sensitivity in Q24 (exact: the table is scaled by a power of two)
+    inline int32_t pitchSensitivity() const {
+        return static_cast<int32_t>(LFO_PMS[config->pitchModSens] * Q24_ONE_F);
+    }
+
+    // Controller value t / n of the way from `from` to `to`
+    static inline int32_t ramp(int32_t from, int32_t to, size_t t, size_t n) {
+        return from + static_cast<int32_t>(static_cast<int64_t>(to - from) * static_cast<int64_t>(t) /
+                                           static_cast<int64_t>(n));
+    }
+
+    // Waveform value (Q24, -1 to 1) of this sample, then advance the phase
+    inline int32_t step(uint32_t phaseInc) {
+        const uint8_t waveform = config->waveform;
+
+        if (waveform > 4) {
+            // Sample & Hold: update value on phase wrap
+            const uint32_t next = phase + phaseInc;
+            if (next < phase) sampleHoldValue = fastRandom();
+            phase = next;
+            return sampleHoldValue;
         }
+
+        int32_t value;
+        if (waveform == 0) {
+            value = Oscillator::waveformQ24<1>(phase);  // Triangle
+        } else if (waveform == 1) {
+            value = Oscillator::waveformQ24<2>(phase);  // Saw down
+        } else if (waveform == 2) {
+            value = Oscillator::waveformQ24<3>(phase);  // Saw up
+        } else if (waveform == 3) {
+            value = Oscillator::waveformQ24<4>(phase);  // Square
+        } else {
+            value = Oscillator::waveformQ24<0>(phase);  // Sine
+        }
+
+        phase += phaseInc;
+        return value;
     }
 
-    inline void process() {
-        if (!config) return;
+    // Unipolar amp mod and pitch offset of one waveform value at the given depths
+    static inline int32_t ampOf(int32_t value, int32_t depth) {
+        return static_cast<int32_t>((static_cast<int64_t>((value + static_cast<int32_t>(Q24_ONE)) >> 1) * depth) >> 24);
+    }
+
+    static inline int32_t pitchOf(int32_t value, int32_t depth, int32_t sensitivity) {
+        return static_cast<int32_t>((((static_cast<int64_t>(value) * depth) >> 24) * sensitivity) >> 24);
+    }
 
+    inline void processSample(uint32_t phaseInc, int32_t pitchDepth, int32_t ampDepth, int32_t pitchSens) {
         if (delaySamples > 0) {
             --delaySamples;
-            ampMod = 0.0f;
-            pitchMod = 1.0f;
+            ampMod = 0;
+            pitchMod = 0;
             return;
         }
 
+        const int32_t value = step(phaseInc);
+        ampMod = ampOf(value, ampDepth);
+        pitchMod = pitchOf(value, pitchDepth, pitchSens);
+    }
+#else
+    LFOPitch pitchMod = 1.0f;
+
+    inline float fastRandom() {
+        randState ^= randState << 13;
+        randState ^= randState >> 17;
+        randState ^= randState << 5;
+        return static_cast<float>(randState) * 4.6566129e-10f * 2.0f - 1.0f;
+    }
+
+    // Waveform value (-1 to 1) of this sample, then advance the phase
+    inline float step() {
+        const uint8_t waveform = config->waveform;
+        
+        if (waveform > 4) {
+            // Sample & Hold: update value on phase wrap
+            phase += LFO_SPEED[config->speed] * INV_SAMPLE_RATE;
+            if (phase >= 1.0f) {
+                phase -= 1.0f;
+                sampleHoldValue = fastRandom();
+            }
+            return sampleHoldValue;
+        }
+
         // Wrap phase
         if (phase >= 1.0f) phase -= 1.0f;
         
         float value;
-        const uint8_t waveform = config->waveform;
-        
         if (waveform == 0) {
             value = LUT::triangle(phase);
         } else if (waveform == 1) {
@@ -65,30 +173,222 @@ public:
             value = -LUT::saw(phase);
         } else if (waveform == 3) {
             value = LUT::square(phase);
-        } else if (waveform == 4) {
+        } else {
             value = LUT::sin(phase);
+        }
+
+        phase += LFO_SPEED[config->speed] * INV_SAMPLE_RATE;
+        return value;
+    }
+#endif
+
+public:
+    LFO() = default;
+
+    void configure(const LFOConfig* lfoConfig) {
+        config = lfoConfig;
+    }
+
+#ifdef FIXED_POINT_ENGINE
+    void trigger() {
+        phase = 0;
+        ampMod = 0;
+        pitchMod = 0;
+        if (config) {
+            delaySamples = static_cast<int>(LFO_DELAY[config->delay] * SAMPLE_RATE);
+        }
+    }
+
+    inline void process() {
+        if (!config) return;
+        processSample(phaseIncrement(), depthQ24(config->pitchModDepth), depthQ24(config->ampModDepth), pitchSensitivity());
+    }
+
+    // Process a block (n <= MAX_BLOCK_SIZE), storing per-sample outputs for the voices
+    inline void processBlock(size_t n) {
+        if (config) {
+            const uint32_t phaseInc = phaseIncrement();
+            const int32_t pitchDepth = depthQ24(config->pitchModDepth);
+            const int32_t ampDepth = depthQ24(config->ampModDepth);
+            const int32_t pitchSens = pitchSensitivity();
+            for (size_t i = 0; i < n; ++i) {
+                processSample(phaseInc, pitchDepth, ampDepth, pitchSens);
+                pitchModBuffer[i] = pitchMod;
+                ampModBuffer[i] = ampMod;
+            }
         } else {
-            // Sample & Hold: update value on phase wrap
-            phase += LFO_SPEED[config->speed] * INV_SAMPLE_RATE;
-            if (phase >= 1.0f) {
-                phase -= 1.0f;
-                sampleHoldValue = fastRandom();
+            for (size_t i = 0; i < n; ++i) {
+                pitchModBuffer[i] = pitchMod;
+                ampModBuffer[i] = ampMod;
             }
-            value = sampleHoldValue;
-            
-            ampMod = (value * 0.5f + 0.5f) * config->ampModDepth * INV_PARAM_99;
-            pitchMod = LUT::exp2(value * config->pitchModDepth * INV_PARAM_99 * LFO_PMS[config->pitchModSens]);
+        }
+    }
+
+    // Process a block with performance controllers folded in, ramped from `from` at the
+    // block start to `to` at its last sample (no zipper steps between blocks)
+    // As on the DX7, the larger of the patch and wheel depths drives the LFO, the EG
+    // bias is a floor under the amp mod, and the LFO delay holds back both depths
+    inline void processBlock(size_t n, const LFOModulation& from, const LFOModulation& to) {
+        if (!config || n == 0) {
+            processBlock(n);
             return;
         }
 
+        const uint32_t phaseInc = phaseIncrement();
+        const int32_t patchPitchDepth = depthQ24(config->pitchModDepth);
+        const int32_t patchAmpDepth = depthQ24(config->ampModDepth);
+        const int32_t pitchSens = pitchSensitivity();
+
+        for (size_t i = 0; i < n; ++i) {
+            const int32_t bend = ramp(from.bend, to.bend, i + 1, n);
+            const int32_t egBias = ramp(from.egBias, to.egBias, i + 1, n);
+
+            if (delaySamples > 0) {
+                --delaySamples;
+                ampMod = egBias;
+                pitchMod = bend;
+            } else {
+                int32_t pitchDepth = ramp(from.pitchDepth, to.pitchDepth, i + 1, n);
+                int32_t ampDepth = ramp(from.ampDepth, to.ampDepth, i + 1, n);
+                if (pitchDepth < patchPitchDepth) pitchDepth = patchPitchDepth;
+                if (ampDepth < patchAmpDepth) ampDepth = patchAmpDepth;
+
+                const int32_t value = step(phaseInc);
+                ampMod = ampOf(value, ampDepth);
+                if (ampMod < egBias) ampMod = egBias;
+                pitchMod = pitchOf(value, pitchDepth, pitchSens) + bend;
+            }
+
+            pitchModBuffer[i] = pitchMod;
+            ampModBuffer[i] = ampMod;
+        }
+    }
+
+    // Advance n samples without producing outputs (no voice is sounding)
+    // Same phase, delay and sample & hold steps as process(), minus the waveform math,
+    // so a free-running LFO is where it would have been when the next note starts
+    inline void skipBlock(size_t n) {
+        if (!config) return;
+        const uint32_t phaseInc = phaseIncrement();
+        const bool sampleHold = config->waveform > 4;
+
+        for (size_t i = 0; i < n; ++i) {
+            if (delaySamples > 0) {
+                --delaySamples;
+                continue;
+            }
+            const uint32_t next = phase + phaseInc;
+            if (sampleHold && next < phase) sampleHoldValue = fastRandom();
+            phase = next;
+        }
+    }
+#else
+    void trigger() {
+        phase = 0.0f;
+        ampMod = 0.0f;
+        pitchMod = 1.0f;
+        if (config) {
+            delaySamples = static_cast<int>(LFO_DELAY[config->delay] * SAMPLE_RATE);
+        }
+    }
+
+    inline void process() {
+        if (!config) return;
+
+        if (delaySamples > 0) {
+            --delaySamples;
+            ampMod = 0.0f;
+            pitchMod = 1.0f;
+            return;
+        }
+
+        const float value = step();
         ampMod = (value * 0.5f + 0.5f) * config->ampModDepth * INV_PARAM_99;
         pitchMod = LUT::exp2(value * config->pitchModDepth * INV_PARAM_99 * LFO_PMS[config->pitchModSens]);
+    }
 
-        phase += LFO_SPEED[config->speed] * INV_SAMPLE_RATE;
+    // Process a block (n <= MAX_BLOCK_SIZE), storing per-sample outputs for the voices
+    inline void processBlock(size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            process();
+            pitchModBuffer[i] = pitchMod;
+            ampModBuffer[i] = ampMod;
+        }
     }
 
-    inline float getAmpMod() const { return ampMod; }
-    inline float getPitchMod() const { return pitchMod; }
+    // Process a block with performance controllers folded in, ramped from `from` at the
+    // block start to `to` at its last sample (no zipper steps between blocks)
+    // As on the DX7, the larger of the patch and wheel depths drives the LFO, the EG
+    // bias is a floor under the amp mod, and the LFO delay holds back both depths
+    inline void processBlock(size_t n, const LFOModulation& from, const LFOModulation& to) {
+        if (!config || n == 0) {
+            processBlock(n);
+            return;
+        }
+
+        const float patchPitchDepth = config->pitchModDepth * INV_PARAM_99;
+        const float patchAmpDepth = config->ampModDepth * INV_PARAM_99;
+        const float pitchSens = LFO_PMS[config->pitchModSens];
+        const float rampStep = 1.0f / static_cast<float>(n);
+
+        for (size_t i = 0; i < n; ++i) {
+            const float t = static_cast<float>(i + 1) * rampStep;
+            const float bend = from.bend + (to.bend - from.bend) * t;
+            const float egBias = from.egBias + (to.egBias - from.egBias) * t;
+
+            if (delaySamples > 0) {
+                --delaySamples;
+                ampMod = egBias;
+                pitchMod = bend;
+            } else {
+                float pitchDepth = from.pitchDepth + (to.pitchDepth - from.pitchDepth) * t;
+                float ampDepth = from.ampDepth + (to.ampDepth - from.ampDepth) * t;
+                if (pitchDepth < patchPitchDepth) pitchDepth = patchPitchDepth;
+                if (ampDepth < patchAmpDepth) ampDepth = patchAmpDepth;
+
+                const float value = step();
+                ampMod = (value * 0.5f + 0.5f) * ampDepth;
+                if (ampMod < egBias) ampMod = egBias;
+                pitchMod = LUT::exp2(value * pitchDepth * pitchSens) * bend;
+            }
+
+            pitchModBuffer[i] = pitchMod;
+            ampModBuffer[i] = ampMod;
+        }
+    }
+
+    // Advance n samples without producing outputs (no voice is sounding)
+    // Same phase, delay and sample & hold steps as process(), minus the waveform math,
+    // so a free-running LFO is where it would have been when the next note starts
+    inline void skipBlock(size_t n) {
+        if (!config) return;
+        const float phaseInc = LFO_SPEED[config->speed] * INV_SAMPLE_RATE;
+        const bool sampleHold = config->waveform > 4;
+
+        for (size_t i = 0; i < n; ++i) {
+            if (delaySamples > 0) {
+                --delaySamples;
+                continue;
+            }
+            if (sampleHold) {
+                phase += phaseInc;
+                if (phase >= 1.0f) {
+                    phase -= 1.0f;
+                    sampleHoldValue = fastRandom();
+                }
+            } else {
+                if (phase >= 1.0f) phase -= 1.0f;
+                phase += phaseInc;
+            }
+        }
+    }
+#endif
+
+    inline LaneSample getAmpMod() const { return ampMod; }
+    inline LFOPitch getPitchMod() const { return pitchMod; }
+    inline const LFOPitch* getPitchModBuffer() const { return pitchModBuffer; }
+    inline const LaneSample* getAmpModBuffer() const { return ampModBuffer; }
+
 };
 
 #endif // LFO_H
\ No newline at end of file
@@ -11,6 +11,73 @@ private:
     static bool lutInitialized;
     static float sinLUT[OSC_LUT_SIZE];
     static float exp2LUT[EXP2_LUT_SIZE];
+    static float velocityLUT[8][128];  // [sensitivity][velocity]
+    static float portamentoLUT[2][100];  // [glissando][time], semitones per sample
+    static float tanhLUT[TANH_LUT_SIZE + 2];  // [-TANH_LUT_RANGE, TANH_LUT_RANGE] plus a guard point for rounding
+#ifdef FIXED_POINT_ENGINE
+    // Delta-coded (next - current, current) pairs, as in msfa sin.h/exp2.h
+    static int32_t sinTableQ24[OSC_LUT_SIZE * 2];
+    static int32_t exp2TableQ30[FIXED_EXP2_SIZE * 2];
+    static int32_t velocityTableQ24[8][128];    // [sensitivity][velocity]
+    static int32_t portamentoTableQ24[2][100];  // [glissando][time], Q24 semitones per sample
+
+    static constexpr int64_t Q30_ONE = int64_t(1) << 30;
+    static constexpr int64_t PI_Q30 = 3373259426;   // pi in Q30
+    static constexpr int64_t LN2_Q30 = 744261118;   // ln(2) in Q30
+
+    // sin(x) for x in [0, pi/2], Q30 in and out (Taylor series to x^19)
+    static int64_t sinSeriesQ30(int64_t x) {
+        static const int64_t DIVISORS[9] = {342, 272, 210, 156, 110, 72, 42, 20, 6};
+        const int64_t x2 = (x * x) >> 30;
+        int64_t t = Q30_ONE;
+        for (int64_t d : DIVISORS) t = Q30_ONE - ((x2 * t) >> 30) / d;
+        return (x * t) >> 30;
+    }
+
+    // sin(2 pi * i / OSC_LUT_SIZE) in Q24, from the first quadrant by symmetry
+    static int32_t sineEntryQ24(size_t i) {
+        const size_t quarter = OSC_LUT_SIZE / 4;
+        const size_t q = (i / quarter) & 3;
+        const size_t r = i % quarter;
+        const int64_t k = static_cast<int64_t>((q & 1) ? quarter - r : r);
+        const int64_t y = (sinSeriesQ30((k * PI_Q30) / static_cast<int64_t>(2 * quarter)) + 32) >> 6;
+        return static_cast<int32_t>((q & 2) ? -y : y);
+    }
+
+    // Velocity factor in Q24: the curve's points rounded to Q24, interpolated in integer
+    static int32_t velocityCurveQ24(int velocity, int sensitivity) {
+        if (velocity < 1) velocity = 1;
+        int32_t points[9];
+        for (int i = 0; i < 9; ++i) {
+            points[i] = static_cast<int32_t>(VELOCITY_FACTOR_TABLE[sensitivity][i] * Q24_ONE_F + 0.5f);
+        }
+        for (int i = 0; i < 8; ++i) {
+            if (velocity <= VELOCITY_POINTS[i] && velocity >= VELOCITY_POINTS[i + 1]) {
+                return points[i + 1] + static_cast<int32_t>(
+                    static_cast<int64_t>(points[i] - points[i + 1]) * (velocity - VELOCITY_POINTS[i + 1]) /
+                    (VELOCITY_POINTS[i] - VELOCITY_POINTS[i + 1]));
+            }
+        }
+        return points[0];
+    }
+#endif
+
+    // Velocity factor: piecewise linear between the VELOCITY_POINTS of the sensitivity's curve
+    static float velocityCurve(int velocity, int sensitivity) {
+        if (velocity < 1) velocity = 1;
+        if (velocity == VELOCITY_POINTS[0]) return VELOCITY_FACTOR_TABLE[sensitivity][0];
+        if (velocity == VELOCITY_POINTS[8]) return VELOCITY_FACTOR_TABLE[sensitivity][8];
+
+        for (int i = 0; i < 8; ++i) {
+            if (velocity <= VELOCITY_POINTS[i] && velocity > VELOCITY_POINTS[i + 1]) {
+                const float t = static_cast<float>(velocity - VELOCITY_POINTS[i + 1]) / 
+                               static_cast<float>(VELOCITY_POINTS[i] - VELOCITY_POINTS[i + 1]);
+                return VELOCITY_FACTOR_TABLE[sensitivity][i + 1] + 
+                       t * (VELOCITY_FACTOR_TABLE[sensitivity][i] - VELOCITY_FACTOR_TABLE[sensitivity][i + 1]);
+            }
+        }
+        return VELOCITY_FACTOR_TABLE[sensitivity][0];
+    }
 
 public:
     // Initialize lookup tables (call once at startup)
@@ -27,6 +94,55 @@ public:
             exp2LUT[i] = exp2f(x);
         }
 
+        for (int sensitivity = 0; sensitivity < 8; ++sensitivity) {
+            for (int velocity = 0; velocity < 128; ++velocity) {
+                velocityLUT[sensitivity][velocity] = velocityCurve(velocity, sensitivity);
+            }
+        }
+
+        // Glide speed curve of msfa porta.cc (CC range 0-127, glissando slower),
+        // sampled at the 100 DX7 portamento times
+        for (int time = 0; time < 100; ++time) {
+            const float cc = static_cast<float>(time) * (127.0f / 99.0f);
+            portamentoLUT[0][time] = 2100.0f * exp2f(-0.062f * cc) * INV_SAMPLE_RATE;
+            portamentoLUT[1][time] = 1300.0f * exp2f(-0.062f * cc) * INV_SAMPLE_RATE;
+        }
+
+        for (size_t i = 0; i < TANH_LUT_SIZE + 2; ++i) {
+            const float x = -TANH_LUT_RANGE + 2.0f * TANH_LUT_RANGE * static_cast<float>(i) / static_cast<float>(TANH_LUT_SIZE);
+            tanhLUT[i] = std::tanh(x);
+        }
+
+#ifdef FIXED_POINT_ENGINE
+        // Integer arithmetic only (no libm): the tables are the same on every platform
+        for (size_t i = 0; i < OSC_LUT_SIZE; ++i) {
+            const int32_t q0 = sineEntryQ24(i);
+            sinTableQ24[2 * i] = sineEntryQ24(i + 1) - q0;
+            sinTableQ24[2 * i + 1] = q0;
+        }
+
+        for (size_t i = 0; i < FIXED_EXP2_SIZE; ++i) {
+            const int64_t q0 = exp2FractionQ30(static_cast<int64_t>(i) << (30 - FIXED_EXP2_BITS));
+            const int64_t q1 = exp2FractionQ30(static_cast<int64_t>(i + 1) << (30 - FIXED_EXP2_BITS));
+            exp2TableQ30[2 * i] = static_cast<int32_t>(q1 - q0);
+            exp2TableQ30[2 * i + 1] = static_cast<int32_t>(q0);
+        }
+
+        for (int sensitivity = 0; sensitivity < 8; ++sensitivity) {
+            for (int velocity = 0; velocity < 128; ++velocity) {
+                velocityTableQ24[sensitivity][velocity] = velocityCurveQ24(velocity, sensitivity);
+            }
+        }
+
+        // Same porta.cc curve in integer: 2^(-0.062 * cc) from the exp2 table above
+        const int64_t sampleRate = static_cast<int64_t>(SAMPLE_RATE);
+        for (int time = 0; time < 100; ++time) {
+            const int64_t speed = exp2Q24(-static_cast<int32_t>((static_cast<int64_t>(time) * 127 * 1040187) / 99));
+            portamentoTableQ24[0][time] = static_cast<int32_t>(2100 * speed / sampleRate);
+            portamentoTableQ24[1][time] = static_cast<int32_t>(1300 * speed / sampleRate);
+        }
+#endif
+
         lutInitialized = true;
     }
 
@@ -37,10 +153,12 @@ public:
         if (phase < 0.0f) phase += 1.0f;
         else if (phase >= 1.0f) phase -= 1.0f;
 
+        // 32-bit indices keep the lookup vectorizable (lane renderer)
         const float index = phase * OSC_LUT_SIZE_F;
-        const size_t i0 = static_cast<size_t>(index);
-        const float frac = index - static_cast<float>(i0);
-        const size_t i1 = (i0 + 1) & (OSC_LUT_SIZE - 1);
+        const int32_t i = static_cast<int32_t>(index);
+        const float frac = index - static_cast<float>(i);
+        const int32_t i0 = i & static_cast<int32_t>(OSC_LUT_SIZE - 1);
+        const int32_t i1 = (i + 1) & static_cast<int32_t>(OSC_LUT_SIZE - 1);
         
         return sinLUT[i0] + frac * (sinLUT[i1] - sinLUT[i0]);
     }
@@ -63,6 +181,74 @@ public:
         return exp2LUT[i0] + frac * (exp2LUT[i0 + 1] - exp2LUT[i0]);
     }
 
+#ifdef FIXED_POINT_ENGINE
+    // 2^(x / 2^30) for x in [0, 2^30], Q30 (series of e^(x ln 2) to the 12th power)
+    // Table-free: also usable before init()
+    static int64_t exp2FractionQ30(int64_t x) {
+        const int64_t y = (x * LN2_Q30) >> 30;
+        int64_t t = Q30_ONE;
+        for (int64_t k = 12; k > 0; --k) t = Q30_ONE + ((y * t) >> 30) / k;
+        return t;
+    }
+
+    // Integer sine: uint32 phase (one cycle = 2^32), Q24 output
+    // Top bits index the table, the next 16 bits interpolate
+    static inline int32_t sinQ24(uint32_t phase) {
+        const uint32_t index = phase >> (32 - OSC_LUT_BITS);
+        const int32_t frac = static_cast<int32_t>((phase >> (16 - OSC_LUT_BITS)) & 0xFFFFu);
+        const int32_t dy = sinTableQ24[2 * index];
+        const int32_t y0 = sinTableQ24[2 * index + 1];
+        return y0 + ((dy * frac) >> 16);
+    }
+
+    // Integer exp2: Q24 in, Q24 out (2^(x / 2^24)), valid for x < 7 << 24
+    static inline int32_t exp2Q24(int32_t x) {
+        const int32_t integer = x >> 24;
+        if (integer < -24) return 0;
+
+        const int32_t frac = x & 0xFFFFFF;
+        const int32_t index = frac >> (24 - FIXED_EXP2_BITS);
+        const int32_t low = frac & ((1 << (24 - FIXED_EXP2_BITS)) - 1);
+        const int32_t dy = exp2TableQ30[2 * index];
+        const int32_t y0 = exp2TableQ30[2 * index + 1];
+        const int32_t y = y0 + static_cast<int32_t>((static_cast<int64_t>(dy) * low) >> (24 - FIXED_EXP2_BITS));
+        return y >> (6 - integer);  // Q30 -> Q24, scaled by 2^integer
+    }
+#endif
+
+    // Velocity factor of a MIDI velocity (0-127) for a key velocity sensitivity (0-7)
+    static inline float velocity(uint8_t midiVelocity, uint8_t sensitivity) {
+        return velocityLUT[(sensitivity > 7) ? 7 : sensitivity][(midiVelocity > 127) ? 127 : midiVelocity];
+    }
+
+    // Portamento speed in semitones per sample for a DX7 portamento time (0-99)
+    static inline float portamentoRate(uint8_t time, bool glissando) {
+        return portamentoLUT[glissando ? 1 : 0][(time > 99) ? 99 : time];
+    }
+
+#ifdef FIXED_POINT_ENGINE
+    // Velocity factor in Q24 (integer engine)
+    static inline int32_t velocityQ24(uint8_t midiVelocity, uint8_t sensitivity) {
+        return velocityTableQ24[(sensitivity > 7) ? 7 : sensitivity][(midiVelocity > 127) ? 127 : midiVelocity];
+    }
+
+    // Portamento speed in Q24 semitones per sample (integer engine)
+    static inline int32_t portamentoRateQ24(uint8_t time, bool glissando) {
+        return portamentoTableQ24[glissando ? 1 : 0][(time > 99) ? 99 : time];
+    }
+#endif
+
+    // Tanh lookup with linear interpolation (saturates to +-1 outside the table)
+    static inline float tanh(float x) {
+        if (x <= -TANH_LUT_RANGE) return -1.0f;
+        if (x >= TANH_LUT_RANGE) return 1.0f;
+
+        const float index = (x + TANH_LUT_RANGE) * TANH_LUT_SCALE;
+        const int32_t i = static_cast<int32_t>(index);
+        const float frac = index - static_cast<float>(i);
+        return tanhLUT[i] + frac * (tanhLUT[i + 1] - tanhLUT[i]);
+    }
+
     // Square wave (expects phase in [0, 1))
     static inline float square(float phase) {
         return (phase < 0.5f) ? 1.0f : -1.0f;
@@ -85,6 +271,18 @@ public:
 bool LUT::lutInitialized = false;
 float LUT::sinLUT[OSC_LUT_SIZE];
 float LUT::exp2LUT[EXP2_LUT_SIZE];
+float LUT::velocityLUT[8][128];
+float LUT::portamentoLUT[2][100];
+float LUT::tanhLUT[TANH_LUT_SIZE + 2];
+#ifdef FIXED_POINT_ENGINE
+int32_t LUT::sinTableQ24[OSC_LUT_SIZE * 2];
+int32_t LUT::exp2TableQ30[FIXED_EXP2_SIZE * 2];
+int32_t LUT::velocityTableQ24[8][128];
+int32_t LUT::portamentoTableQ24[2][100];
+constexpr int64_t LUT::Q30_ONE;
+constexpr int64_t LUT::PI_Q30;
+constexpr int64_t LUT::LN2_Q30;
+#endif
 #endif
 
 #endif // LUT_H
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef NOTE_STACK_H
+#define NOTE_STACK_H
+
+#include "constants.h"
+
+// Keys held in monophonic mode, in press order (last-note priority)
+// Releasing the sounding key hands the voice back to the previous one still held;
+// past NOTE_STACK_SIZE keys the oldest is forgotten
+class NoteStack {
+private:
+    uint8_t notes[NOTE_STACK_SIZE] = {0};
+    size_t count = 0;
+
+public:
+    NoteStack() = default;
+
+    void push(uint8_t midiNote) {
+        remove(midiNote);
+        if (count == NOTE_STACK_SIZE) {
+            for (size_t i = 1; i < count; ++i) notes[i - 1] = notes[i];
+            --count;
+        }
+        notes[count++] = midiNote;
+    }
+
+    // False if midiNote was not held
+    bool remove(uint8_t midiNote) {
+        for (size_t i = 0; i < count; ++i) {
+            if (notes[i] != midiNote) continue;
+            for (size_t j = i + 1; j < count; ++j) notes[j - 1] = notes[j];
+            --count;
+            return true;
+        }
+        return false;
+    }
+
+    void clear() { count = 0; }
+    bool empty() const { return count == 0; }
+
+    // Most recent held key (stack not empty)
+    uint8_t top() const { return notes[count - 1]; }
+};
+
+#endif // NOTE_STACK_H
@@ -5,37 +5,90 @@
 #include "envelope.h"
 #include "config.h"
 #include "lut.h"
+#include "tuning.h"
+#include "voice_lanes.h"
+
+// Note-on values of one operator for every MIDI key, built once per preset
+struct OperatorNoteTable {
+    LanePhase phaseInc[128];     // Oscillator phase increment
+    LaneSample levelScaling[128];  // Keyboard level scaling factor
+    int8_t rateScaling[128];     // Envelope rate scaling
+};
+
+// Operator settings changed by a live edit (bit flags), refreshed on sounding notes
+namespace OperatorChange {
+    constexpr uint8_t FREQUENCY = 1u << 0;     // Coarse, fine, detune, fixed mode
+    constexpr uint8_t LEVEL = 1u << 1;         // Output level, keyboard level scaling
+    constexpr uint8_t ENVELOPE = 1u << 2;      // Envelope rates and levels
+    constexpr uint8_t RATE_SCALING = 1u << 3;  // Keyboard rate scaling
+    constexpr uint8_t VELOCITY = 1u << 4;      // Velocity sensitivity
+
+    // Changes that invalidate the operator's note table
+    constexpr uint8_t NOTE_TABLE = FREQUENCY | LEVEL | RATE_SCALING;
+}
 
 // FM operator: oscillator + envelope with velocity/level scaling
+// View over one lane of the voice lane storage (bindLane() before use): the envelope
+// runs here at control rate, the per-sample state lives in OperatorLanes
 class Operator {
 private:
     Oscillator osc;
     Envelope env;
+    OperatorLanes* lanes = nullptr;
+    size_t lane = 0;
     
     const OperatorConfig* config = nullptr;
     
-    // Cached values (computed on trigger, not per-sample)
-    float calculatedFrequency = 440.0f;
-    float velocityFactor = 1.0f;
-    float levelScalingFactor = 1.0f;
-    float feedbackLevel = 0.0f;
-    float previousOutput = 0.0f;
+    const OperatorNoteTable* noteTable = nullptr;  // Per-preset note-on values, nullptr = compute
     
-    // Cached config values for hot path
-    float cachedAmpModSens = 0.0f;
+    // Cached values (computed on trigger, not per-sample)
+    uint8_t noteVelocity = 0;  // Velocity of the last trigger, for refresh()
+    LanePhase notePhaseInc = 0;  // Phase increment of the note's key (before glide)
+    LaneSample velocityFactor = LANE_ONE;
+    LaneSample levelScalingFactor = LANE_ONE;
+    LaneSample envelopeGain = 0;  // Envelope gain reached at the end of the last sub-block
     bool isOn = false;
 
-    static inline float midiToFrequency(uint8_t midiNote) {
-        return 13.75f * exp2f((static_cast<float>(midiNote) - 9.0f) / 12.0f);
+    // Envelope gain in the lane sample format
+    inline LaneSample currentGain() const {
+#ifdef FIXED_POINT_ENGINE
+        return env.getGainQ24();
+#else
+        return env.getGain();
+#endif
     }
-    
-    void updateFrequency(float baseFrequency) {
-        if (!config) {
-            calculatedFrequency = 0.0f;
-            return;
-        }
-        
-        const FrequencyConfig* freq = &config->frequency;
+
+    // Velocity factor in the lane sample format
+    static inline LaneSample velocityGain(uint8_t velocity, uint8_t sensitivity) {
+#ifdef FIXED_POINT_ENGINE
+        return LUT::velocityQ24(velocity, sensitivity);
+#else
+        return LUT::velocity(velocity, sensitivity);
+#endif
+    }
+
+    // Velocity * level scaling, the operator's gain over its envelope
+    inline LaneSample levelGain() const {
+#ifdef FIXED_POINT_ENGINE
+        return static_cast<LaneSample>((static_cast<int64_t>(velocityFactor) * levelScalingFactor) >> 24);
+#else
+        return velocityFactor * levelScalingFactor;
+#endif
+    }
+
+    // Amplitude modulation sensitivity (0-3) in the lane sample format
+    static inline LaneSample ampModSensitivity(uint8_t sensitivity) {
+#ifdef FIXED_POINT_ENGINE
+        return static_cast<LaneSample>((static_cast<uint32_t>(sensitivity) << 24) / 3);
+#else
+        return sensitivity * INV_PARAM_3;
+#endif
+    }
+
+    // Operator frequency for a key sounding at keyFrequency (Hz, from the tuning):
+    // ratio (coarse, fine, detune) or fixed frequency
+    static float computeFrequency(const OperatorConfig& opConfig, float keyFrequency) {
+        const FrequencyConfig* freq = &opConfig.frequency;
         float baseFreq;
         float detuneMultiplier = 1.0f;
         
@@ -44,7 +97,7 @@ private:
         } else {
             const float coarseValue = (freq->coarse == 0) ? 0.5f : static_cast<float>(freq->coarse);
             const float fineFactor = 1.0f + static_cast<float>(freq->fine) * 0.01f;
-            baseFreq = baseFrequency * coarseValue * fineFactor;
+            baseFreq = keyFrequency * coarseValue * fineFactor;
 
             if (freq->detune != 7) {
                 const int detuneIdx = (freq->detune < 7) ? (7 - freq->detune) : (freq->detune - 7);
@@ -53,9 +106,34 @@ private:
             }
         }
         
-        calculatedFrequency = baseFreq * detuneMultiplier;
-        osc.setFrequency(calculatedFrequency);
+        return baseFreq * detuneMultiplier;
+    }
+
+#ifdef FIXED_POINT_ENGINE
+    // computeFrequency() in integer, as a phase increment from the key's increment
+    // (the tuning table's): exact ratios for coarse, fine and detune
+    static uint32_t computePhaseIncrement(const OperatorConfig& opConfig, uint32_t keyIncrement) {
+        const FrequencyConfig* freq = &opConfig.frequency;
+        uint64_t increment;
+
+        if (freq->fixedFrequency) {
+            const uint64_t base = static_cast<uint64_t>(FIXED_FREQ_BASE[freq->coarse % 4]);
+            const uint64_t fine = static_cast<uint64_t>(FIXED_FREQ_FINE_VALUES[freq->fine] * 65536.0f + 0.5f);  // Q16
+            increment = ((base * fine) << 16) / static_cast<uint64_t>(SAMPLE_RATE);
+        } else {
+            increment = (freq->coarse == 0) ? keyIncrement / 2 : static_cast<uint64_t>(keyIncrement) * freq->coarse;
+            increment = increment * (100u + freq->fine) / 100u;
+
+            if (freq->detune != 7) {
+                const int detuneIdx = (freq->detune < 7) ? (7 - freq->detune) : (freq->detune - 7);
+                const uint64_t detuneAmount = static_cast<uint64_t>(DETUNE_TABLE[detuneIdx] * 1000.0f + 0.5f);  // Millionths
+                increment = increment * ((freq->detune < 7) ? 1000000u - detuneAmount : 1000000u + detuneAmount) / 1000000u;
+            }
+        }
+
+        return static_cast<uint32_t>((increment < FIXED_MAX_PHASE_INC) ? increment : FIXED_MAX_PHASE_INC);
     }
+#endif
 
     static int scaleRate(uint8_t midinote, uint8_t sensitivity) {
         int x = static_cast<int>(midinote) / 3 - 7;
@@ -69,29 +147,10 @@ private:
         return qratedelta;
     }
 
-    float computeVelocityFactor(uint8_t velocity, uint8_t sensitivity) const {
-        if (velocity < 1) velocity = 1;
-        else if (velocity > 127) velocity = 127;
-        if (sensitivity > 7) sensitivity = 7;
-
-        if (velocity == VELOCITY_POINTS[0]) return VELOCITY_FACTOR_TABLE[sensitivity][0];
-        if (velocity == VELOCITY_POINTS[8]) return VELOCITY_FACTOR_TABLE[sensitivity][8];
-
-        for (int i = 0; i < 8; ++i) {
-            if (velocity <= VELOCITY_POINTS[i] && velocity > VELOCITY_POINTS[i + 1]) {
-                const float t = static_cast<float>(velocity - VELOCITY_POINTS[i + 1]) / 
-                               static_cast<float>(VELOCITY_POINTS[i] - VELOCITY_POINTS[i + 1]);
-                return VELOCITY_FACTOR_TABLE[sensitivity][i + 1] + 
-                       t * (VELOCITY_FACTOR_TABLE[sensitivity][i] - VELOCITY_FACTOR_TABLE[sensitivity][i + 1]);
-            }
-        }
-        return VELOCITY_FACTOR_TABLE[sensitivity][0];
-    }
-
-    float scaleLevel(uint8_t midiNote, uint8_t outputLevel, uint8_t breakpoint, 
-                     uint8_t leftDepth, uint8_t rightDepth,
-                     uint8_t leftCurve, uint8_t rightCurve) const {
-        if (!leftDepth && !rightDepth) return 1.0f;
+    static LaneSample scaleLevel(uint8_t midiNote, uint8_t outputLevel, uint8_t breakpoint, 
+                            uint8_t leftDepth, uint8_t rightDepth,
+                            uint8_t leftCurve, uint8_t rightCurve) {
+        if (!leftDepth && !rightDepth) return LANE_ONE;
 
         const int offset = static_cast<int>(midiNote) - static_cast<int>(breakpoint) - 17;
         
@@ -125,78 +184,366 @@ private:
         if (clampedWithScale > 127) clampedWithScale = 127;
         
         const int effectiveScale = clampedWithScale - scaledOutlevel;
+#ifdef FIXED_POINT_ENGINE
+        return LUT::exp2Q24(effectiveScale << 5);
+#else
         return LUT::exp2(static_cast<float>(effectiveScale << 5) * INV_Q24_ONE);
+#endif
     }
     
+    // Phase modulation source of a lane render
+    enum class LaneModulation : uint8_t { None, Input, Feedback };
+
+#ifdef FIXED_POINT_ENGINE
+    // Integer variant: uint32 phase wraps on overflow, Q24 samples and gains, 64-bit products
+    template<uint8_t WAVEFORM, LaneModulation MODULATION>
+    static inline void renderLanesWaveform(OperatorLanes& op, const LaneRow* phaseMod,
+                                           const PitchRow* pitchMod, const LaneSample* ampMod,
+                                           LaneSample ampModSens, float feedback,
+                                           LaneRow* out, size_t begin, size_t end, size_t n) {
+        const int64_t feedbackScale = static_cast<int64_t>(feedback * 65536.0f);  // Q16 (exact: powers of two), * 256 below = phase units
+        uint32_t phase[POLYPHONY], phaseInc[POLYPHONY];
+        int32_t gain[POLYPHONY], gainStep[POLYPHONY], previous[POLYPHONY], row[POLYPHONY];
+        for (size_t v = begin; v < end; ++v) {
+            phase[v] = op.phase[v];
+            phaseInc[v] = op.phaseInc[v];
+            gain[v] = op.gain[v];
+            gainStep[v] = op.gainStep[v];
+            previous[v] = op.previousOutput[v];
+        }
+
+        for (size_t k = 0; k < n; ++k) {
+            const int64_t ampModGain = Q24_ONE - ((static_cast<int64_t>(ampMod[k]) * ampModSens) >> 24);
+            for (size_t v = begin; v < end; ++v) {
+                uint32_t modulation = 0;
+                if (MODULATION == LaneModulation::Input) {
+                    modulation = static_cast<uint32_t>(phaseMod[k][v]) * FIXED_MODULATION_SCALE;
+                } else if (MODULATION == LaneModulation::Feedback) {
+                    modulation = static_cast<uint32_t>((previous[v] * feedbackScale) >> 8);
+                }
+
+                const uint32_t modulatedPhase = phase[v] + modulation;
+                phase[v] += static_cast<uint32_t>((static_cast<uint64_t>(phaseInc[v]) *
+                                                   static_cast<uint32_t>(pitchMod[k][v])) >> 24);
+
+                gain[v] += gainStep[v];
+
+                const int32_t value = static_cast<int32_t>(
+                    (static_cast<int64_t>(Oscillator::waveformQ24<WAVEFORM>(modulatedPhase)) * gain[v]) >> 24);
+                if (MODULATION == LaneModulation::Feedback) previous[v] = value;
+                row[v] = static_cast<int32_t>((value * ampModGain) >> (24 + FIXED_OPERATOR_SHIFT));
+            }
+            for (size_t v = begin; v < end; ++v) out[k][v] = row[v];
+        }
+
+        for (size_t v = begin; v < end; ++v) {
+            op.phase[v] = phase[v];
+            op.gain[v] = gain[v];
+            op.previousOutput[v] = previous[v];
+        }
+    }
+#else
+    // Render lanes [begin, end) over n samples for one waveform - vectorizes across voices
+    // Lane state is held in locals for the block and each output row is staged locally:
+    // with no stores through pointers in the inner loop, the table lookups can vectorize
+    template<uint8_t WAVEFORM, LaneModulation MODULATION>
+    static inline void renderLanesWaveform(OperatorLanes& op, const LaneRow* phaseMod,
+                                           const PitchRow* pitchMod, const LaneSample* ampMod,
+                                           LaneSample ampModSens, float feedback,
+                                           LaneRow* out, size_t begin, size_t end, size_t n) {
+        float phase[POLYPHONY], phaseInc[POLYPHONY], gain[POLYPHONY], gainStep[POLYPHONY];
+        float previous[POLYPHONY], row[POLYPHONY];
+        for (size_t v = begin; v < end; ++v) {
+            phase[v] = op.phase[v];
+            phaseInc[v] = op.phaseInc[v];
+            gain[v] = op.gain[v];
+            gainStep[v] = op.gainStep[v];
+            previous[v] = op.previousOutput[v];
+        }
+
+        for (size_t k = 0; k < n; ++k) {
+            const float ampModGain = 1.0f - ampMod[k] * ampModSens;
+            for (size_t v = begin; v < end; ++v) {
+                float modulation = 0.0f;
+                if (MODULATION == LaneModulation::Input) modulation = phaseMod[k][v] * MODULATION_SCALING;
+                else if (MODULATION == LaneModulation::Feedback) modulation = feedback * previous[v];
+
+                float modulatedPhase = phase[v] + modulation;
+                modulatedPhase -= floorf(modulatedPhase);
+
+                float basePhase = phase[v] + phaseInc[v] * pitchMod[k][v];
+                if (basePhase >= 1.0f) basePhase -= 1.0f;
+                else if (basePhase < 0.0f) basePhase += 1.0f;
+                phase[v] = basePhase;
+
+                gain[v] += gainStep[v];
+
+                const float value = Oscillator::waveform<WAVEFORM>(modulatedPhase) * gain[v];
+                if (MODULATION == LaneModulation::Feedback) previous[v] = value;
+                row[v] = value * ampModGain * OPERATOR_SCALING;
+            }
+            for (size_t v = begin; v < end; ++v) out[k][v] = row[v];
+        }
+
+        for (size_t v = begin; v < end; ++v) {
+            op.phase[v] = phase[v];
+            op.gain[v] = gain[v];
+            op.previousOutput[v] = previous[v];
+        }
+    }
+#endif
+
+    template<LaneModulation MODULATION>
+    static inline void renderLanesDispatch(uint8_t waveform, OperatorLanes& op, const LaneRow* phaseMod,
+                                           const PitchRow* pitchMod, const LaneSample* ampMod,
+                                           LaneSample ampModSens, float feedback,
+                                           LaneRow* out, size_t begin, size_t end, size_t n) {
+        switch (waveform) {
+            case 1:  renderLanesWaveform<1, MODULATION>(op, phaseMod, pitchMod, ampMod, ampModSens, feedback, out, begin, end, n); break;
+            case 2:  renderLanesWaveform<2, MODULATION>(op, phaseMod, pitchMod, ampMod, ampModSens, feedback, out, begin, end, n); break;
+            case 3:  renderLanesWaveform<3, MODULATION>(op, phaseMod, pitchMod, ampMod, ampModSens, feedback, out, begin, end, n); break;
+            case 4:  renderLanesWaveform<4, MODULATION>(op, phaseMod, pitchMod, ampMod, ampModSens, feedback, out, begin, end, n); break;
+            default: renderLanesWaveform<0, MODULATION>(op, phaseMod, pitchMod, ampMod, ampModSens, feedback, out, begin, end, n); break;
+        }
+    }
+
 public:
     Operator() = default;
+
+    // Attach this operator to one lane (voice index) of the lane storage
+    void bindLane(OperatorLanes* operatorLanes, size_t laneIndex) {
+        lanes = operatorLanes;
+        lane = laneIndex;
+        osc.bind(&lanes->phase[lane], &lanes->phaseInc[lane]);
+    }
     
+    // Use precomputed note-on values (built from this operator's config), nullptr to compute (12-TET)
+    void bindNoteTable(const OperatorNoteTable* table) { noteTable = table; }
+
+    // Tabulate the per-key note-on values of opConfig under a tuning
+    static void buildNoteTable(const OperatorConfig& opConfig, const TuningTable& tuning, OperatorNoteTable& table) {
+        Oscillator tableOsc;
+        for (uint8_t note = 0; note < 128; ++note) {
+#ifdef FIXED_POINT_ENGINE
+            table.phaseInc[note] = computePhaseIncrement(opConfig, tuning.phaseIncrement[note]);
+#else
+            tableOsc.bind(nullptr, &table.phaseInc[note]);
+            tableOsc.setFrequency(computeFrequency(opConfig, tuning.frequency[note]));
+#endif
+            table.levelScaling[note] = scaleLevel(note, opConfig.envelope.outputLevel, opConfig.lvlSclBreakpoint,
+                                                  opConfig.lvlSclLeftDepth, opConfig.lvlSclRightDepth,
+                                                  opConfig.lvlSclLeftCurve, opConfig.lvlSclRightCurve);
+            table.rateScaling[note] = static_cast<int8_t>(scaleRate(note, opConfig.envelope.rateScaling));
+        }
+    }
+
+    // Settings that differ between two configs (OperatorChange flags)
+    static uint8_t changes(const OperatorConfig& from, const OperatorConfig& to) {
+        uint8_t changed = 0;
+        if (from.frequency.fixedFrequency != to.frequency.fixedFrequency || from.frequency.detune != to.frequency.detune ||
+            from.frequency.coarse != to.frequency.coarse || from.frequency.fine != to.frequency.fine) {
+            changed |= OperatorChange::FREQUENCY;
+        }
+        if (from.envelope.outputLevel != to.envelope.outputLevel || from.lvlSclBreakpoint != to.lvlSclBreakpoint ||
+            from.lvlSclLeftDepth != to.lvlSclLeftDepth || from.lvlSclRightDepth != to.lvlSclRightDepth ||
+            from.lvlSclLeftCurve != to.lvlSclLeftCurve || from.lvlSclRightCurve != to.lvlSclRightCurve) {
+            changed |= OperatorChange::LEVEL;
+        }
+        if (from.envelope.outputLevel != to.envelope.outputLevel ||  // Also part of the envelope target
+            from.envelope.l1 != to.envelope.l1 || from.envelope.l2 != to.envelope.l2 ||
+            from.envelope.l3 != to.envelope.l3 || from.envelope.l4 != to.envelope.l4 ||
+            from.envelope.r1 != to.envelope.r1 || from.envelope.r2 != to.envelope.r2 ||
+            from.envelope.r3 != to.envelope.r3 || from.envelope.r4 != to.envelope.r4) {
+            changed |= OperatorChange::ENVELOPE;
+        }
+        if (from.envelope.rateScaling != to.envelope.rateScaling) changed |= OperatorChange::RATE_SCALING;
+        if (from.velocitySensitivity != to.velocitySensitivity) changed |= OperatorChange::VELOCITY;
+        return changed;
+    }
+
     void setConfig(const OperatorConfig* opConfig) {
         config = opConfig;
         if (config) {
             env.setConfig(&config->envelope);
+            envelopeGain = currentGain();
             isOn = config->on;
-            cachedAmpModSens = config->ampModSens * INV_PARAM_3;
         }
     }
     
-    void setFeedback(uint8_t feedbackValue) {
-        if (feedbackValue > MAX_FEEDBACK_VALUE) feedbackValue = MAX_FEEDBACK_VALUE;
-        feedbackLevel = FEEDBACK_TABLE[feedbackValue];
+    // Switch to a new config while sounding (config snapshot swap): the envelope
+    // keeps its state, the new values apply from the next trigger or envelope stage
+    void replaceConfig(const OperatorConfig* opConfig) {
+        if (!opConfig) return;
+        config = opConfig;
+        env.replaceConfig(&config->envelope);
+        isOn = config->on;
     }
     
+    // Note-on: a few table loads when a note table is bound
     void trigger(uint8_t midiNote, uint8_t velocity) {
-        const float baseFrequency = midiToFrequency(midiNote);
-        updateFrequency(baseFrequency);
+        midiNote &= 0x7F;
+        noteVelocity = velocity;
+        velocityFactor = velocityGain(velocity, config->velocitySensitivity);
 
-        velocityFactor = computeVelocityFactor(velocity, config->velocitySensitivity);
-        levelScalingFactor = scaleLevel(midiNote, config->envelope.outputLevel, config->lvlSclBreakpoint, 
-                                        config->lvlSclLeftDepth, config->lvlSclRightDepth,
-                                        config->lvlSclLeftCurve, config->lvlSclRightCurve);
+        int rateScaling;
+        if (noteTable) {
+            osc.setPhaseIncrement(noteTable->phaseInc[midiNote]);
+            levelScalingFactor = noteTable->levelScaling[midiNote];
+            rateScaling = noteTable->rateScaling[midiNote];
+        } else {
+#ifdef FIXED_POINT_ENGINE
+            osc.setPhaseIncrement(computePhaseIncrement(*config, TuningTable::standardPhaseIncrement(midiNote)));
+#else
+            osc.setFrequency(computeFrequency(*config, TuningTable::standardFrequency(midiNote)));
+#endif
+            levelScalingFactor = scaleLevel(midiNote, config->envelope.outputLevel, config->lvlSclBreakpoint, 
+                                            config->lvlSclLeftDepth, config->lvlSclRightDepth,
+                                            config->lvlSclLeftCurve, config->lvlSclRightCurve);
+            rateScaling = scaleRate(midiNote, config->envelope.rateScaling);
+        }
         
+        notePhaseInc = osc.getPhaseIncrement();
         if (config->OSCKeySync) osc.reset();
 
-        env.setRateScaling(scaleRate(midiNote, config->envelope.rateScaling));
-        env.trigger();
-        previousOutput = 0.0f;
+        env.trigger(rateScaling);
+        lanes->previousOutput[lane] = 0;
     }
     
+    // Apply a live edit to the sounding note on midiNote (after replaceConfig()): only
+    // the values named by changed (OperatorChange flags) are recomputed, the phase and
+    // envelope level carry on
+    void refresh(uint8_t changed, uint8_t midiNote) {
+        if (!config || !env.isActive()) return;
+        midiNote &= 0x7F;
+
+        if (changed & OperatorChange::VELOCITY) {
+            velocityFactor = velocityGain(noteVelocity, config->velocitySensitivity);
+        }
+        if (changed & OperatorChange::FREQUENCY) {
+            if (noteTable) osc.setPhaseIncrement(noteTable->phaseInc[midiNote]);
+#ifdef FIXED_POINT_ENGINE
+            else osc.setPhaseIncrement(computePhaseIncrement(*config, TuningTable::standardPhaseIncrement(midiNote)));
+#else
+            else osc.setFrequency(computeFrequency(*config, TuningTable::standardFrequency(midiNote)));
+#endif
+            notePhaseInc = osc.getPhaseIncrement();
+        }
+        if (changed & OperatorChange::LEVEL) {
+            levelScalingFactor = noteTable ? noteTable->levelScaling[midiNote]
+                                           : scaleLevel(midiNote, config->envelope.outputLevel, config->lvlSclBreakpoint,
+                                                        config->lvlSclLeftDepth, config->lvlSclRightDepth,
+                                                        config->lvlSclLeftCurve, config->lvlSclRightCurve);
+        }
+        if (changed & (OperatorChange::ENVELOPE | OperatorChange::RATE_SCALING)) {
+            env.update(noteTable ? noteTable->rateScaling[midiNote] : scaleRate(midiNote, config->envelope.rateScaling));
+        }
+    }
+
+#ifdef FIXED_POINT_ENGINE
+    // Glide: play octaves (Q24, 0 = on the key) away from the note's frequency; fixed-
+    // frequency operators do not follow. Control rate, once per block while a glide runs
+    void setPitchOffset(int32_t octaves) {
+        if (!config || config->frequency.fixedFrequency) return;
+        if (octaves == 0) {
+            osc.setPhaseIncrement(notePhaseInc);
+            return;
+        }
+        const int whole = octaves >> 24;
+        uint64_t increment = (static_cast<uint64_t>(notePhaseInc) * static_cast<uint32_t>(LUT::exp2Q24(octaves & 0xFFFFFF))) >> 24;
+        increment = (whole >= 0) ? increment << whole : increment >> -whole;
+        osc.setPhaseIncrement(static_cast<LanePhase>((increment < FIXED_MAX_PHASE_INC) ? increment : FIXED_MAX_PHASE_INC));
+    }
+#else
+    // Glide: play at ratio times the note's frequency (1 = on the key); fixed-frequency
+    // operators do not follow. Control rate, once per block while a glide runs
+    void setPitchRatio(float ratio) {
+        if (!config || config->frequency.fixedFrequency) return;
+        osc.setPhaseIncrement((ratio == 1.0f) ? notePhaseInc
+                                              : static_cast<LanePhase>(static_cast<float>(notePhaseInc) * ratio));
+    }
+#endif
+
     void release() { env.release(); }
     
     void reset() {
         osc.reset();
         env.reset();
-        previousOutput = 0.0f;
+        envelopeGain = currentGain();
+        lanes->previousOutput[lane] = 0;
     }
 
     bool isActive() const { return env.isActive(); }
-    
-    // Process with modulation - ampMod passed directly to avoid per-sample setter
-    inline float process(float phaseMod, float pitchMod, float ampMod) {
-        if (!isOn) return 0.0f;
-        
-        const float envelopeLevel = env.process();
-        const float oscillatorValue = osc.process(phaseMod, pitchMod, config->waveform);
-        const float ampModFactor = ampMod * cachedAmpModSens;
-        
-        return oscillatorValue * envelopeLevel * velocityFactor * levelScalingFactor * (1.0f - ampModFactor);
+    bool isRising() const { return isOn && env.isRising(); }
+
+    // Output amplitude bound reached at the end of the last block (envelope * velocity
+    // * level scaling), 0 for a disabled operator
+    LaneSample getOutputGain() const {
+        if (!isOn) return 0;
+#ifdef FIXED_POINT_ENGINE
+        return static_cast<LaneSample>((static_cast<int64_t>(envelopeGain) * levelGain()) >> 24);
+#else
+        return envelopeGain * velocityFactor * levelScalingFactor;
+#endif
     }
     
-    // Process with feedback - ampMod passed directly
-    inline float processWithFeedback(float pitchMod, float ampMod) {
-        if (!isOn) return 0.0f;
-        
-        const float envelopeLevel = env.process();
-        
-        const float phaseMod = feedbackLevel * previousOutput * FEEDBACK_SCALING;
-        const float oscillatorValue = osc.process(phaseMod, pitchMod, config->waveform);
-        const float gainedOutput = oscillatorValue * envelopeLevel * velocityFactor * levelScalingFactor;
+    // Advance the envelope over the next block (n <= N, control rate) and set this
+    // lane's gain ramp from the previous envelope gain to the new one
+    inline void prepareBlock(size_t n) {
+        if (!isOn) {
+            lanes->gain[lane] = 0;
+            lanes->gainStep[lane] = 0;
+            return;
+        }
         
-        previousOutput = gainedOutput;
-        const float ampModFactor = ampMod * cachedAmpModSens;
+        const LaneSample previousGain = envelopeGain;
+        env.advance(static_cast<uint32_t>(n));
+        envelopeGain = currentGain();
+#ifdef FIXED_POINT_ENGINE
+        const int64_t scale = levelGain();
+        const int32_t start = static_cast<int32_t>((previousGain * scale) >> 24);
+        const int32_t target = static_cast<int32_t>((envelopeGain * scale) >> 24);
+        lanes->gain[lane] = start;
+        lanes->gainStep[lane] = (target - start) / static_cast<int32_t>(n);
+#else
+        const float scale = levelGain();
+        lanes->gain[lane] = previousGain * scale;
+        lanes->gainStep[lane] = (envelopeGain - previousGain) * scale / static_cast<float>(n);
+#endif
+    }
 
-        return gainedOutput * (1.0f - ampModFactor);
+    // Mute this lane for the lane renderer (voice inactive); trigger() restores the increment
+    inline void silenceLane() {
+        lanes->gain[lane] = 0;
+        lanes->gainStep[lane] = 0;
+        lanes->phaseInc[lane] = 0;
     }
+
+    // Render one operator for lanes [begin, end) of the lane storage - SoA hot path
+    // Buffers are [sample][voice]; phaseMod is the unscaled sum of the modulators,
+    // nullptr for unmodulated operators. Output includes OPERATOR_SCALING
+    static inline void renderLanes(const OperatorConfig& opConfig, OperatorLanes& op,
+                                   const LaneRow* phaseMod, const PitchRow* pitchMod,
+                                   const LaneSample* ampMod, LaneRow* out, size_t begin, size_t end, size_t n) {
+        const LaneSample ampModSens = ampModSensitivity(opConfig.ampModSens);
+        if (phaseMod) {
+            renderLanesDispatch<LaneModulation::Input>(opConfig.waveform, op, phaseMod, pitchMod, ampMod,
+                                                       ampModSens, 0.0f, out, begin, end, n);
+        } else {
+            renderLanesDispatch<LaneModulation::None>(opConfig.waveform, op, nullptr, pitchMod, ampMod,
+                                                      ampModSens, 0.0f, out, begin, end, n);
+        }
+    }
+
+    // Render the self-feedback operator for lanes [begin, end)
+    static inline void renderLanesWithFeedback(const OperatorConfig& opConfig, OperatorLanes& op, uint8_t feedbackValue,
+                                               const PitchRow* pitchMod, const LaneSample* ampMod,
+                                               LaneRow* out, size_t begin, size_t end, size_t n) {
+        if (feedbackValue > MAX_FEEDBACK_VALUE) feedbackValue = MAX_FEEDBACK_VALUE;
+        renderLanesDispatch<LaneModulation::Feedback>(opConfig.waveform, op, nullptr, pitchMod, ampMod,
+                                  ampModSensitivity(opConfig.ampModSens), FEEDBACK_TABLE[feedbackValue] * FEEDBACK_SCALING,
+                                  out, begin, end, n);
+    }
+
 };
 
 #endif // OPERATOR_H
\ No newline at end of file
@@ -3,52 +3,126 @@
 
 #include "constants.h"
 #include "lut.h"
+#include "voice_lanes.h"
 
 // Phase accumulator oscillator with FM support and multiple waveforms
+// View over one lane of the voice lane storage: phase and increment live in
+// OperatorLanes so the lane renderer can advance all voices together
+// With FIXED_POINT_ENGINE the phase is a uint32 (one cycle = 2^32) and waveforms are Q24
 class Oscillator {
 private:    
-    float phase = 0.0f;
-    float phaseInc = 0.0f;  // Cached: frequency * INV_SAMPLE_RATE
+    LanePhase* phase = nullptr;
+    LanePhase* phaseInc = nullptr;  // Cached: frequency * INV_SAMPLE_RATE (in cycles)
     
 public:
+    Oscillator() = default;
+    Oscillator(LanePhase* phaseSlot, LanePhase* phaseIncSlot) : phase(phaseSlot), phaseInc(phaseIncSlot) {}
+
+    void bind(LanePhase* phaseSlot, LanePhase* phaseIncSlot) {
+        phase = phaseSlot;
+        phaseInc = phaseIncSlot;
+    }
+
     void setFrequency(float freq) {
         // Clamp frequency to valid range and precompute phase increment
         if (freq < 0.0f) freq = 0.0f;
         else if (freq > 20000.0f) freq = 20000.0f;
-        phaseInc = freq * INV_SAMPLE_RATE;
+#ifdef FIXED_POINT_ENGINE
+        *phaseInc = static_cast<LanePhase>(freq * (PHASE_CYCLE_F * INV_SAMPLE_RATE));
+#else
+        *phaseInc = freq * INV_SAMPLE_RATE;
+#endif
     }
     
-    float getFrequency() const { return phaseInc * SAMPLE_RATE; }
+    // Precomputed increment (note tables)
+    void setPhaseIncrement(LanePhase increment) { *phaseInc = increment; }
+    LanePhase getPhaseIncrement() const { return *phaseInc; }
+
+#ifdef FIXED_POINT_ENGINE
+    float getFrequency() const { return static_cast<float>(*phaseInc) * (SAMPLE_RATE / PHASE_CYCLE_F); }
+#else
+    float getFrequency() const { return *phaseInc * SAMPLE_RATE; }
+#endif
     
-    void reset() { phase = 0.0f; }
+    void reset() { *phase = 0; }
+
+    // Waveform of an already wrapped phase [0, 1), selected at compile time
+    // waveform: 0=sine, 1=triangle, 2=saw down, 3=saw up, 4=square
+    template<uint8_t WAVEFORM>
+    static inline float waveform(float wrappedPhase) {
+        switch (WAVEFORM) {
+            case 1:  return LUT::triangle(wrappedPhase);
+            case 2:  return LUT::saw(wrappedPhase);            // Saw down
+            case 3:  return -LUT::saw(wrappedPhase);           // Saw up
+            case 4:  return LUT::square(wrappedPhase);
+            default: return LUT::sin(wrappedPhase);            // 0 or invalid = sine
+        }
+    }
+
+#ifdef FIXED_POINT_ENGINE
+    // Integer waveform of a uint32 phase, Q24 output
+    template<uint8_t WAVEFORM>
+    static inline int32_t waveformQ24(uint32_t phaseValue) {
+        const int32_t ramp = static_cast<int32_t>(phaseValue >> 7);  // 2 * phase in Q24
+        switch (WAVEFORM) {
+            case 1: {
+                const int32_t centered = ramp - static_cast<int32_t>(Q24_ONE);
+                return static_cast<int32_t>(Q24_ONE) - 2 * (centered < 0 ? -centered : centered);
+            }
+            case 2:  return static_cast<int32_t>(Q24_ONE) - ramp;
+            case 3:  return ramp - static_cast<int32_t>(Q24_ONE);
+            case 4:  return (phaseValue < 0x80000000u) ? static_cast<int32_t>(Q24_ONE) : -static_cast<int32_t>(Q24_ONE);
+            default: return LUT::sinQ24(phaseValue);
+        }
+    }
+#endif
     
     // Process with phase modulation, pitch multiplier, and waveform selection
+    // phaseMod: phase offset in cycles
     // pitchMod: frequency multiplier (1.0 = no change, 2.0 = octave up)
     // waveform: 0=sine, 1=triangle, 2=saw down, 3=saw up, 4=square
-    inline float process(float phaseMod, float pitchMod, uint8_t waveform) {
+#ifdef FIXED_POINT_ENGINE
+    inline float process(float phaseMod, float pitchMod, uint8_t waveformIndex) {
+        const uint32_t modulatedPhase = *phase + static_cast<uint32_t>(static_cast<int64_t>(phaseMod * PHASE_CYCLE_F));
+        const uint64_t pitch = static_cast<uint64_t>(lanePitch(pitchMod));
+        *phase += static_cast<uint32_t>((static_cast<uint64_t>(*phaseInc) * pitch) >> 24);
+
+        int32_t value;
+        switch (waveformIndex) {
+            case 1:  value = waveformQ24<1>(modulatedPhase); break;
+            case 2:  value = waveformQ24<2>(modulatedPhase); break;
+            case 3:  value = waveformQ24<3>(modulatedPhase); break;
+            case 4:  value = waveformQ24<4>(modulatedPhase); break;
+            default: value = waveformQ24<0>(modulatedPhase); break;
+        }
+        return laneSampleToFloat(value);
+    }
+#else
+    inline float process(float phaseMod, float pitchMod, uint8_t waveformIndex) {
         // Modulated phase for output
-        float modulatedPhase = phase + phaseMod;
+        float modulatedPhase = *phase + phaseMod;
         
-        // Single conditional wrap (handles ±1 range from typical FM modulation)
-        if (modulatedPhase >= 1.0f) modulatedPhase -= 1.0f;
-        else if (modulatedPhase < 0.0f) modulatedPhase += 1.0f;
+        // Full wrap: summed modulators can push the phase well beyond ±1
+        modulatedPhase -= floorf(modulatedPhase);
 
         // Advance base phase with pitch modulation
-        phase += phaseInc * pitchMod;
+        float basePhase = *phase + *phaseInc * pitchMod;
         
         // Wrap base phase
-        if (phase >= 1.0f) phase -= 1.0f;
-        else if (phase < 0.0f) phase += 1.0f;
+        if (basePhase >= 1.0f) basePhase -= 1.0f;
+        else if (basePhase < 0.0f) basePhase += 1.0f;
+        *phase = basePhase;
         
         // Select waveform (branch prediction friendly: sine is most common)
-        switch (waveform) {
-            case 1:  return LUT::triangle(modulatedPhase);
-            case 2:  return LUT::saw(modulatedPhase);          // Saw down
-            case 3:  return -LUT::saw(modulatedPhase);         // Saw up
-            case 4:  return LUT::square(modulatedPhase);
-            default: return LUT::sin(modulatedPhase);          // 0 or invalid = sine
+        switch (waveformIndex) {
+            case 1:  return waveform<1>(modulatedPhase);
+            case 2:  return waveform<2>(modulatedPhase);
+            case 3:  return waveform<3>(modulatedPhase);
+            case 4:  return waveform<4>(modulatedPhase);
+            default: return waveform<0>(modulatedPhase);
         }
     }
+#endif
 };
 
 #endif // OSCILLATOR_H
\ No newline at end of file
@@ -40,6 +40,26 @@ struct Params {
     // Default: 1
     uint8_t midiChannel = 1;
     
+    // Portamento time (0 = off, 1-99 = slow glide at 99)
+    // Default: 0
+    uint8_t portamentoTime = 0;
+    
+    // Glissando: portamento moves in semitone steps
+    // Default: false
+    bool glissando = false;
+    
+    // Unison: voices stacked per key (1 = off, up to UNISON_MAX_VOICES)
+    // Default: 1
+    uint8_t unisonVoices = 1;
+    
+    // Unison detune: spread of the stacked voices' pitch (99 = +-UNISON_MAX_DETUNE semitones)
+    // Range: 0-99, Default: 0
+    uint8_t unisonDetune = 0;
+    
+    // Unison stereo spread (0 = all centred, 99 = outer voices hard left/right)
+    // Range: 0-99, Default: 0
+    uint8_t unisonSpread = 0;
+    
     Params() = default;
     
     Params(uint8_t pbRange, uint8_t mwIntensity, ModWheelAssignment mwAssign, uint8_t midiCh)
@@ -52,6 +72,11 @@ struct Params {
         modWheelIntensity = 0;
         modWheelAssignment = ModWheelAssignment(false, false, false);
         midiChannel = 1;
+        portamentoTime = 0;
+        glissando = false;
+        unisonVoices = 1;
+        unisonDetune = 0;
+        unisonSpread = 0;
     }
     
     // Load parameters from a file
@@ -80,13 +105,15 @@ struct Params {
             return false;
         }
         
-        if (version != PARAMS_VERSION) {
+        if (version < 1 || version > PARAMS_VERSION) {
             file.close();
             setDefaults();
             return false;
         }
         
-        // Read parameters
+        // Read parameters: fields are only ever appended, so an older file leaves the
+        // fields it predates at their defaults
+        setDefaults();
         bool success = true;
         success &= (file.read((uint8_t*)&pitchBendRange, sizeof(pitchBendRange)) == sizeof(pitchBendRange));
         success &= (file.read((uint8_t*)&modWheelIntensity, sizeof(modWheelIntensity)) == sizeof(modWheelIntensity));
@@ -94,6 +121,15 @@ struct Params {
         success &= (file.read((uint8_t*)&modWheelAssignment.ampModDepth, sizeof(bool)) == sizeof(bool));
         success &= (file.read((uint8_t*)&modWheelAssignment.egBias, sizeof(bool)) == sizeof(bool));
         success &= (file.read((uint8_t*)&midiChannel, sizeof(midiChannel)) == sizeof(midiChannel));
+        if (version >= 2) {  // Portamento
+            success &= (file.read((uint8_t*)&portamentoTime, sizeof(portamentoTime)) == sizeof(portamentoTime));
+            success &= (file.read((uint8_t*)&glissando, sizeof(bool)) == sizeof(bool));
+        }
+        if (version >= 3) {  // Unison
+            success &= (file.read((uint8_t*)&unisonVoices, sizeof(unisonVoices)) == sizeof(unisonVoices));
+            success &= (file.read((uint8_t*)&unisonDetune, sizeof(unisonDetune)) == sizeof(unisonDetune));
+            success &= (file.read((uint8_t*)&unisonSpread, sizeof(unisonSpread)) == sizeof(unisonSpread));
+        }
         
         file.close();
         
@@ -121,13 +157,15 @@ struct Params {
             return false;
         }
         
-        if (version != PARAMS_VERSION) {
+        if (version < 1 || version > PARAMS_VERSION) {
             fclose(file);
             setDefaults();
             return false;
         }
         
-        // Read parameters
+        // Read parameters: fields are only ever appended, so an older file leaves the
+        // fields it predates at their defaults
+        setDefaults();
         bool success = true;
         success &= (fread(&pitchBendRange, sizeof(pitchBendRange), 1, file) == 1);
         success &= (fread(&modWheelIntensity, sizeof(modWheelIntensity), 1, file) == 1);
@@ -135,6 +173,15 @@ struct Params {
         success &= (fread(&modWheelAssignment.ampModDepth, sizeof(bool), 1, file) == 1);
         success &= (fread(&modWheelAssignment.egBias, sizeof(bool), 1, file) == 1);
         success &= (fread(&midiChannel, sizeof(midiChannel), 1, file) == 1);
+        if (version >= 2) {  // Portamento
+            success &= (fread(&portamentoTime, sizeof(portamentoTime), 1, file) == 1);
+            success &= (fread(&glissando, sizeof(bool), 1, file) == 1);
+        }
+        if (version >= 3) {  // Unison
+            success &= (fread(&unisonVoices, sizeof(unisonVoices), 1, file) == 1);
+            success &= (fread(&unisonDetune, sizeof(unisonDetune), 1, file) == 1);
+            success &= (fread(&unisonSpread, sizeof(unisonSpread), 1, file) == 1);
+        }
         
         fclose(file);
         #endif
@@ -179,6 +226,11 @@ struct Params {
         success &= (file.write((uint8_t*)&modWheelAssignment.ampModDepth, sizeof(bool)) == sizeof(bool));
         success &= (file.write((uint8_t*)&modWheelAssignment.egBias, sizeof(bool)) == sizeof(bool));
         success &= (file.write((uint8_t*)&midiChannel, sizeof(midiChannel)) == sizeof(midiChannel));
+        success &= (file.write((uint8_t*)&portamentoTime, sizeof(portamentoTime)) == sizeof(portamentoTime));
+        success &= (file.write((uint8_t*)&glissando, sizeof(bool)) == sizeof(bool));
+        success &= (file.write((uint8_t*)&unisonVoices, sizeof(unisonVoices)) == sizeof(unisonVoices));
+        success &= (file.write((uint8_t*)&unisonDetune, sizeof(unisonDetune)) == sizeof(unisonDetune));
+        success &= (file.write((uint8_t*)&unisonSpread, sizeof(unisonSpread)) == sizeof(unisonSpread));
         
         file.close();
         
@@ -206,6 +258,11 @@ struct Params {
         success &= (fwrite(&modWheelAssignment.ampModDepth, sizeof(bool), 1, file) == 1);
         success &= (fwrite(&modWheelAssignment.egBias, sizeof(bool), 1, file) == 1);
         success &= (fwrite(&midiChannel, sizeof(midiChannel), 1, file) == 1);
+        success &= (fwrite(&portamentoTime, sizeof(portamentoTime), 1, file) == 1);
+        success &= (fwrite(&glissando, sizeof(bool), 1, file) == 1);
+        success &= (fwrite(&unisonVoices, sizeof(unisonVoices), 1, file) == 1);
+        success &= (fwrite(&unisonDetune, sizeof(unisonDetune), 1, file) == 1);
+        success &= (fwrite(&unisonSpread, sizeof(unisonSpread), 1, file) == 1);
         
         fclose(file);
         #endif
@@ -223,6 +280,15 @@ struct Params {
         
         // MIDI channel: 0-16 (0 = OMNI)
         if (midiChannel > 16) midiChannel = 16;
+        
+        // Portamento time: 0-99
+        if (portamentoTime > 99) portamentoTime = 99;
+        
+        // Unison: 1-UNISON_MAX_VOICES voices, detune and spread 0-99
+        if (unisonVoices < 1) unisonVoices = 1;
+        else if (unisonVoices > UNISON_MAX_VOICES) unisonVoices = UNISON_MAX_VOICES;
+        if (unisonDetune > 99) unisonDetune = 99;
+        if (unisonSpread > 99) unisonSpread = 99;
     }
     
     // Print current parameters (for debugging)
@@ -236,6 +302,9 @@ struct Params {
         std::cout << "  - Amp Mod Depth: " << (modWheelAssignment.ampModDepth ? "ON" : "OFF") << "\n";
         std::cout << "  - EG Bias: " << (modWheelAssignment.egBias ? "ON" : "OFF") << "\n";
         std::cout << "MIDI Channel: " << static_cast<int>(midiChannel) << (midiChannel == 0 ? " (OMNI)" : "") << "\n";
+        std::cout << "Portamento Time: " << static_cast<int>(portamentoTime) << (glissando ? " (glissando)" : "") << "\n";
+        std::cout << "Unison: " << static_cast<int>(unisonVoices) << " voices, detune " << static_cast<int>(unisonDetune)
+                  << ", spread " << static_cast<int>(unisonSpread) << "\n";
         std::cout << "=========================" << std::endl;
         #endif
 
@@ -259,6 +328,18 @@ struct Params {
             Serial.print(F(" (OMNI)")); 
         }
         Serial.println();
+        Serial.print(F("Portamento Time: "));
+        Serial.print(portamentoTime);
+        if (glissando) {
+            Serial.print(F(" (glissando)"));
+        }
+        Serial.println();
+        Serial.print(F("Unison: "));
+        Serial.print(unisonVoices);
+        Serial.print(F(" voices, detune "));
+        Serial.print(unisonDetune);
+        Serial.print(F(", spread "));
+        Serial.println(unisonSpread);
         Serial.println(F("========================="));
         #endif
     }
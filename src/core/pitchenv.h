@@ -6,7 +6,8 @@
 #include "lut.h"
 
 // Pitch envelope: returns frequency multiplier (1.0 = no change)
-// Internally works in Q24 log domain (like Dexed), converts to float on output
+// Internally works in Q24 log domain (like Dexed), converts to float on output;
+// processLog() hands the log level to the integer engine
 class PitchEnvelope {
 private:
     const PitchEnvelopeConfig* config = nullptr;
@@ -52,6 +53,16 @@ public:
         }
     }
 
+    // Switch to a new config without disturbing the running stage (next stage uses it)
+    void replaceConfig(const PitchEnvelopeConfig* pitchEnvConfig) {
+        if (pitchEnvConfig) config = pitchEnvConfig;
+    }
+
+    // Retarget the running stage after a config change (live edit)
+    void refresh() {
+        if (config && stage < 4) advanceStage(stage);
+    }
+
     void trigger() {
         if (!config) return;
         keyDown = true;
@@ -64,9 +75,9 @@ public:
         advanceStage(3);
     }
 
-    // Process one sample, returns frequency multiplier
-    inline float process() {
-        if (!config) return 1.0f;
+    // Process one sample, returns the pitch offset in octaves (Q24)
+    inline int32_t processLog() {
+        if (!config) return 0;
 
         // Process stages 0-2 always, stage 3 only on release
         const bool shouldProcess = (stage < 3) || (stage == 3 && !keyDown);
@@ -87,7 +98,12 @@ public:
             }
         }
 
-        return LUT::exp2(static_cast<float>(level) * INV_Q24_ONE);
+        return level;
+    }
+
+    // Process one sample, returns frequency multiplier
+    inline float process() {
+        return LUT::exp2(static_cast<float>(processLog()) * INV_Q24_ONE);
     }
 
     void reset() {
@@ -0,0 +1,51 @@
+#ifndef POLYPHONY_GOVERNOR_H
+#define POLYPHONY_GOVERNOR_H
+
+#include "constants.h"
+
+// Adaptive voice limit driven by measured audio CPU load
+// Fed periodically with the render load (percent of the audio deadline, e.g.
+// AudioProcessorUsage() on Teensy) and the number of sounding voices:
+// - above GOVERNOR_HIGH_LOAD the limit drops below the current voice count at once
+// - below GOVERNOR_LOW_LOAD, while the limit is what caps the voices, it rises by one
+//   every GOVERNOR_RAISE_UPDATES readings, if the per-voice cost says one more fits
+class PolyphonyGovernor {
+private:
+    uint8_t limit = DEFAULT_VOICE_LIMIT;
+    uint8_t raiseCountdown = GOVERNOR_RAISE_UPDATES;
+
+public:
+    PolyphonyGovernor() = default;
+
+    // Returns the new voice limit (MIN_VOICE_LIMIT to POLYPHONY)
+    uint8_t update(float loadPercent, size_t activeVoices) {
+        if (loadPercent > GOVERNOR_HIGH_LOAD) {
+            size_t lowered = (activeVoices < limit) ? activeVoices : limit;
+            if (lowered > 0) --lowered;
+            limit = static_cast<uint8_t>((lowered < MIN_VOICE_LIMIT) ? MIN_VOICE_LIMIT : lowered);
+            raiseCountdown = GOVERNOR_RAISE_UPDATES;
+            return limit;
+        }
+
+        // Only a limit that is actually reached says anything about headroom
+        if (loadPercent > GOVERNOR_LOW_LOAD || activeVoices < limit || limit >= POLYPHONY) {
+            raiseCountdown = GOVERNOR_RAISE_UPDATES;
+            return limit;
+        }
+
+        if (--raiseCountdown == 0) {
+            raiseCountdown = GOVERNOR_RAISE_UPDATES;
+            const float perVoice = loadPercent / static_cast<float>(activeVoices);
+            if (perVoice * static_cast<float>(limit + 1) < GOVERNOR_HIGH_LOAD) ++limit;
+        }
+        return limit;
+    }
+
+    uint8_t getLimit() const { return limit; }
+    void setLimit(uint8_t voices) {
+        limit = (voices < MIN_VOICE_LIMIT) ? MIN_VOICE_LIMIT : (voices > POLYPHONY) ? POLYPHONY : voices;
+        raiseCountdown = GOVERNOR_RAISE_UPDATES;
+    }
+};
+
+#endif // POLYPHONY_GOVERNOR_H
@@ -0,0 +1,145 @@
+#ifndef SAMPLE_FORMAT_H
+#define SAMPLE_FORMAT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+// Block conversion of the float output to int16 (Teensy DAC, 16-bit WAV files)
+// and int24 (24-bit WAV files, scalar: PC only)
+// out = saturate16(round(in * gain * 32767 + dither)), rounding to nearest even
+// - Cortex-M7: VCVTR to int32 then SSAT #16, no compare branches
+// - PC: SSE2 (x86) or NEON (AArch64), four samples per step, saturating pack
+// - scalar fallback elsewhere, same results up to float rounding
+// Optional TPDF dither: triangular, +-1 LSB peak, from four xorshift32 generators
+// used round-robin (one per SIMD lane), so every path produces the same samples
+namespace SampleFormat {
+    constexpr float INT16_SCALE = 32767.0f;
+    constexpr float INT24_SCALE = 8388607.0f;
+    constexpr float DITHER_SCALE = 1.0f / 65536.0f;  // Two 16-bit uniforms -> LSB
+
+    struct Dither {
+        uint32_t state[4];
+
+        explicit Dither(uint32_t seed = 0x9E3779B9u) { reseed(seed); }
+
+        void reseed(uint32_t seed) {
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                const uint32_t value = (seed + lane) * 0x9E3779B9u;
+                state[lane] = value ? value : 0x6D2B79F5u;  // xorshift must not start at 0
+            }
+        }
+
+        // Next dither value of one lane, in LSB (-1, 1)
+        inline float next(size_t lane) {
+            uint32_t x = state[lane];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            state[lane] = x;
+            return static_cast<float>(static_cast<int32_t>((x & 0xFFFFu) + (x >> 16)) - 65535) * DITHER_SCALE;
+        }
+    };
+
+    inline int16_t roundSaturate(float x) {
+#if defined(__ARM_ARCH_7EM__)
+        int32_t result;
+        asm("vcvtr.s32.f32 %0, %0" : "+t"(x));  // Round per FPSCR (nearest), saturates to int32
+        asm("vmov %0, %1" : "=r"(result) : "t"(x));
+        asm("ssat %0, #16, %1" : "=r"(result) : "r"(result));
+        return static_cast<int16_t>(result);
+#else
+        if (x > INT16_SCALE) x = INT16_SCALE;
+        else if (x < -32768.0f) x = -32768.0f;
+        return static_cast<int16_t>(lrintf(x));
+#endif
+    }
+
+    // Convert n samples; dither may be null (plain rounding)
+    inline void toInt16(const float* input, int16_t* output, size_t n, float gain, Dither* dither = nullptr) {
+        const float scale = gain * INT16_SCALE;
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        const __m128 scaleVector = _mm_set1_ps(scale);
+        const __m128 high = _mm_set1_ps(INT16_SCALE);
+        const __m128 low = _mm_set1_ps(-32768.0f);
+        if (dither) {
+            __m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dither->state));
+            const __m128i lowMask = _mm_set1_epi32(0xFFFF);
+            const __m128i offset = _mm_set1_epi32(65535);
+            const __m128 ditherScale = _mm_set1_ps(DITHER_SCALE);
+            for (; i + 4 <= n; i += 4) {
+                state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+                state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+                state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+                const __m128i sum = _mm_sub_epi32(_mm_add_epi32(_mm_and_si128(state, lowMask),
+                                                                _mm_srli_epi32(state, 16)), offset);
+                __m128 x = _mm_mul_ps(_mm_loadu_ps(input + i), scaleVector);
+                x = _mm_add_ps(x, _mm_mul_ps(_mm_cvtepi32_ps(sum), ditherScale));
+                x = _mm_max_ps(_mm_min_ps(x, high), low);  // cvtps overflows to INT_MIN, clamp first
+                const __m128i q = _mm_cvtps_epi32(x);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(q, q));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dither->state), state);
+        } else {
+            for (; i + 4 <= n; i += 4) {
+                __m128 x = _mm_mul_ps(_mm_loadu_ps(input + i), scaleVector);
+                x = _mm_max_ps(_mm_min_ps(x, high), low);
+                const __m128i q = _mm_cvtps_epi32(x);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(q, q));
+            }
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        const float32x4_t scaleVector = vdupq_n_f32(scale);
+        if (dither) {
+            uint32x4_t state = vld1q_u32(dither->state);
+            const uint32x4_t lowMask = vdupq_n_u32(0xFFFF);
+            const int32x4_t offset = vdupq_n_s32(65535);
+            for (; i + 4 <= n; i += 4) {
+                state = veorq_u32(state, vshlq_n_u32(state, 13));
+                state = veorq_u32(state, vshrq_n_u32(state, 17));
+                state = veorq_u32(state, vshlq_n_u32(state, 5));
+                const int32x4_t sum = vsubq_s32(vreinterpretq_s32_u32(
+                    vaddq_u32(vandq_u32(state, lowMask), vshrq_n_u32(state, 16))), offset);
+                float32x4_t x = vmulq_f32(vld1q_f32(input + i), scaleVector);
+                x = vmlaq_n_f32(x, vcvtq_f32_s32(sum), DITHER_SCALE);
+                vst1_s16(output + i, vqmovn_s32(vcvtnq_s32_f32(x)));  // Both steps saturate
+            }
+            vst1q_u32(dither->state, state);
+        } else {
+            for (; i + 4 <= n; i += 4) {
+                const float32x4_t x = vmulq_f32(vld1q_f32(input + i), scaleVector);
+                vst1_s16(output + i, vqmovn_s32(vcvtnq_s32_f32(x)));
+            }
+        }
+#endif
+
+        // Remaining samples (all of them on the scalar and Cortex-M7 paths)
+        if (dither) {
+            for (; i < n; ++i) output[i] = roundSaturate(input[i] * scale + dither->next(i & 3));
+        } else {
+            for (; i < n; ++i) output[i] = roundSaturate(input[i] * scale);
+        }
+    }
+
+    // Convert n samples to 24-bit values (in int32); dither may be null
+    inline void toInt24(const float* input, int32_t* output, size_t n, float gain, Dither* dither = nullptr) {
+        const float scale = gain * INT24_SCALE;
+        for (size_t i = 0; i < n; ++i) {
+            float x = input[i] * scale;
+            if (dither) x += dither->next(i & 3);
+            if (x > INT24_SCALE) x = INT24_SCALE;
+            else if (x < -8388608.0f) x = -8388608.0f;
+            output[i] = static_cast<int32_t>(lrintf(x));
+        }
+    }
+}
+
+#endif // SAMPLE_FORMAT_H
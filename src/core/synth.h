@@ -1,31 +1,413 @@
 #ifndef SYNTH_H
 #define SYNTH_H
 
+#include <atomic>
 #include "constants.h"
 #include "config.h"
 #include "voice.h"
+#include "voice_allocator.h"
+#include "note_stack.h"
+#include "polyphony_governor.h"
+#include "event_queue.h"
 #include "lfo.h"
+#include "controllers.h"
 #include "params.h"
+#include "tuning.h"
+#include "effects.h"
 
 // Forward declaration
 class MidiHandler;
 
+// Immutable config snapshot read by the audio side
+// The control side fills an unused snapshot from its staging SynthConfig, derives
+// the note-on tables there, then publishes it; the audio side switches to it at
+// the next block boundary and never sees a half-written config
+struct SynthSnapshot {
+    SynthConfig config = SynthConfig();
+    VoiceNoteTables noteTables = {};  // Derived from config.voiceConfig and the tuning
+    uint32_t version = 0;             // Publish count, 0 = never published
+    uint32_t tuningVersion = 0;       // Tuning the note tables were built with
+    bool resetVoices = false;         // Preset change: reset voices on adoption
+
+    // Live edit: what changed since the previous snapshot (OperatorChange flags),
+    // recomputed on the sounding voices only
+    uint8_t operatorChanges[NUM_OPERATORS] = {0};
+    bool pitchEnvelopeChanged = false;
+};
+
 // Polyphonic FM synthesizer
 class Synth {
 private:
+    VoiceLanes lanes = {};  // SoA render state, one lane per voice
     std::array<Voice, POLYPHONY> voices = {};
-    std::array<uint64_t, POLYPHONY> voiceAge = {0}; 
-    uint64_t globalAgeCounter = 0;
-    int activeNoteCount = 0;
+    VoiceAllocator allocator = {};  // Active/held voice masks and note->voice map
+    NoteStack monoNotes = {};       // Held keys in monophonic mode
+    int lastVoice = -1;             // Voice of the latest note, where portamento starts
+    LaneSample releaseCullGain = 0;  // Linear release culling threshold, 0 = off
+    uint32_t culledVoiceCount = 0;  // Voices retired by release culling
+    PolyphonyGovernor governor = {};                        // Control side
+    std::atomic<uint8_t> voiceLimit{DEFAULT_VOICE_LIMIT};   // Runtime voice limit (<= POLYPHONY), control side writes
+    std::atomic<uint8_t> activeVoiceCount{0};               // Sounding voices after the last block, audio side writes
+    std::atomic<uint32_t> shedVoiceCount{0};                // Voices retired to meet a lowered limit
+
+    // Control events from the control loop, applied at their sample time by processBlock()
+    EventQueue<SynthEvent, EVENT_QUEUE_SIZE> events;
+    std::atomic<uint32_t> sampleTime{0};  // Samples rendered so far (audio side writes)
+    Controllers controllers = {};         // Pitch bend and mod wheel, applied per block
+
+    // Double-buffered config: the audio side reads activeSnapshot, the control side
+    // writes the other one and hands it over through pendingSnapshot
+    SynthSnapshot snapshots[2];
+    std::atomic<SynthSnapshot*> activeSnapshot{nullptr};   // Written by the audio side
+    std::atomic<SynthSnapshot*> pendingSnapshot{nullptr};  // Published, not yet adopted
+    uint32_t publishedVersion = 0;                 // Control side
+    const SynthConfig* deferredConfig = nullptr;   // Publish refused while one was pending
+    bool deferredReset = false;
+    const SynthConfig* stagingConfig = nullptr;    // Last staging config, republished on a tuning change
+
+    // Key frequencies (control side): note tables are rebuilt from it on a tuning change
+    TuningTable tuning = {};
+    uint32_t tuningVersion = 0;
 
     LFO lfo = {};
+    Algorithm algorithm = {};  // Routing shared by all voices for the lane renderer
+    FxChain effects;           // Post-voice effects, run over each processBlock() call
     
     MidiHandler* midiHandler = nullptr;
 
+    // Retire voices until no more than limit sound: quietest released voices
+    // first, then the quietest held ones
+    void shedVoices(size_t limit) {
+        while (allocator.getActiveCount() > limit) {
+            const uint32_t active = allocator.getActiveMask();
+            const uint32_t released = active & ~allocator.getHeldMask();
+            const uint32_t candidates = released ? released : active;
+
+            size_t quietest = VoiceAllocator::lowestVoice(candidates);
+            LaneSample quietestGain = voices[quietest].getCarrierGain();
+            for (uint32_t m = candidates & (candidates - 1); m; m &= m - 1) {
+                const size_t v = VoiceAllocator::lowestVoice(m);
+                const LaneSample gain = voices[v].getCarrierGain();
+                if (gain < quietestGain) {
+                    quietest = v;
+                    quietestGain = gain;
+                }
+            }
+
+            voices[quietest].noteOff();
+            voices[quietest].silenceLanes();
+            allocator.retire(quietest);
+            shedVoiceCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Voices stacked per key: the unison setting, within the voice limit
+    size_t unisonCount(size_t limit) const {
+        const size_t count = (params.unisonVoices < 1) ? 1 : params.unisonVoices;
+        return (count < limit) ? count : limit;
+    }
+
+    // Detune and stereo position of unison voice index (of count), spread evenly
+    // from one side to the other; a single voice sits on the key, centred
+    void placeVoice(size_t v, size_t index, size_t count) {
+#ifdef FIXED_POINT_ENGINE
+        const int64_t position = (count > 1) ? static_cast<int64_t>((2 * index) << 24) / static_cast<int64_t>(count - 1) - Q24_ONE : 0;
+        const int64_t maxDetune = static_cast<int64_t>(UNISON_MAX_DETUNE * Q24_ONE_F);  // Exact: a power of two
+        voices[v].setDetune(static_cast<VoicePitch>((position * params.unisonDetune * maxDetune / 99) >> 24));
+        voices[v].setPan(static_cast<LaneSample>(position * params.unisonSpread / 99));
+#else
+        const float position = (count > 1) ? 2.0f * static_cast<float>(index) / static_cast<float>(count - 1) - 1.0f : 0.0f;
+        voices[v].setDetune(position * static_cast<float>(params.unisonDetune) * INV_PARAM_99 * UNISON_MAX_DETUNE);
+        voices[v].setPan(position * static_cast<float>(params.unisonSpread) * INV_PARAM_99);
+#endif
+    }
+
+    // Portamento time set and the switch (CC#65) not released
+    bool portamentoActive() const {
+        return params.portamentoTime > 0 && controllers.getPortamentoSwitch();
+    }
+
+    void startGlide(size_t v, VoicePitch fromPitch) {
+#ifdef FIXED_POINT_ENGINE
+        voices[v].glideFrom(fromPitch, LUT::portamentoRateQ24(params.portamentoTime, params.glissando), params.glissando);
+#else
+        voices[v].glideFrom(fromPitch, LUT::portamentoRate(params.portamentoTime, params.glissando), params.glissando);
+#endif
+    }
+
+    // Apply one control event (audio side)
+    void applyEvent(const SynthEvent& event) {
+        switch (event.type) {
+            case SynthEvent::NoteOn:
+                if (event.data2 > 0) noteOn(event.data1, static_cast<uint8_t>(event.data2));
+                else noteOff(event.data1);
+                break;
+            case SynthEvent::NoteOff:
+                noteOff(event.data1);
+                break;
+            case SynthEvent::ControlChange:
+                controlChange(event.data1, static_cast<uint8_t>(event.data2));
+                break;
+            case SynthEvent::PitchBend:
+                setPitchBend(event.data2);
+                break;
+        }
+    }
+
+    // Copy staging into the snapshot the audio side is not using and publish it
+    // (control side); false if the previous publish has not been adopted yet
+    bool publish(const SynthConfig* staging, bool resetVoices) {
+        if (pendingSnapshot.load(std::memory_order_acquire)) return false;
+
+        const SynthSnapshot* active = activeSnapshot.load(std::memory_order_acquire);
+        SynthSnapshot* next = (active == &snapshots[0]) ? &snapshots[1] : &snapshots[0];
+
+        // Rebuild only the note tables whose operator changed since this snapshot was
+        // filled, or all of them under a new tuning
+        const bool retuned = next->version == 0 || next->tuningVersion != tuningVersion;
+        for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+            const OperatorConfig& opConfig = staging->voiceConfig.operatorConfigs[i];
+            if (retuned ||
+                (Operator::changes(next->config.voiceConfig.operatorConfigs[i], opConfig) & OperatorChange::NOTE_TABLE)) {
+                Operator::buildNoteTable(opConfig, tuning, next->noteTables.operators[i]);
+            }
+        }
+        next->tuningVersion = tuningVersion;
+
+        // Changes against the snapshot being played, for the sounding voices
+        const bool transposed = active && active->config.voiceConfig.transpose != staging->voiceConfig.transpose;
+        const bool tuningChanged = active && active->tuningVersion != tuningVersion;
+        for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+            uint8_t changed = active ? Operator::changes(active->config.voiceConfig.operatorConfigs[i],
+                                                         staging->voiceConfig.operatorConfigs[i]) : 0;
+            if (transposed) changed |= OperatorChange::NOTE_TABLE;  // Another key of the tables
+            if (tuningChanged) changed |= OperatorChange::FREQUENCY;
+            next->operatorChanges[i] = changed;
+        }
+        next->pitchEnvelopeChanged = active && pitchEnvelopeDiffers(active->config.pitchEnvelopeConfig,
+                                                                    staging->pitchEnvelopeConfig);
+
+        next->config = *staging;
+        next->version = ++publishedVersion;
+        next->resetVoices = resetVoices;
+        pendingSnapshot.store(next, std::memory_order_release);
+        return true;
+    }
+
+    static bool pitchEnvelopeDiffers(const PitchEnvelopeConfig& from, const PitchEnvelopeConfig& to) {
+        return from.l1 != to.l1 || from.l2 != to.l2 || from.l3 != to.l3 || from.l4 != to.l4 ||
+               from.r1 != to.r1 || from.r2 != to.r2 || from.r3 != to.r3 || from.r4 != to.r4;
+    }
+
+    // Publish now, or keep staging for flushConfig(); the latest staging replaces an
+    // older deferred one, but a deferred preset load stays a reset
+    bool requestPublish(const SynthConfig* staging, bool resetVoices) {
+        if (!staging) return false;
+        stagingConfig = staging;
+        deferredConfig = staging;
+        deferredReset = deferredReset || resetVoices;
+        return flushConfig();
+    }
+
+    // Switch to a published snapshot (audio side, block boundary)
+    // A preset change resets the voices; a live edit repoints them and lets the
+    // sounding notes carry on. The old snapshot is released to the control side
+    void adoptPendingSnapshot() {
+        SynthSnapshot* next = pendingSnapshot.load(std::memory_order_acquire);
+        if (!next) return;
+
+        const bool wasMonophonic = config && config->monophonic;
+        config = &next->config;
+        lfo.configure(&config->lfoConfig);
+        algorithm.setConfig(config->voiceConfig.algorithm);
+
+        if (next->resetVoices) {
+            for (auto& voice : voices) {
+                voice.configure(&config->voiceConfig);
+                voice.setPitchEnvelopeConfig(&config->pitchEnvelopeConfig);
+                voice.bindNoteTables(&next->noteTables);
+                voice.setLFO(&lfo);
+                voice.silenceLanes();  // configure() resets the voice
+            }
+            allocator.reset();
+            monoNotes.clear();
+            lastVoice = -1;
+        } else {
+            // Held notes were allocated under the other voice mode: release them
+            if (config->monophonic != wasMonophonic) allNotesOff();
+            for (auto& voice : voices) {
+                voice.updateConfig(&config->voiceConfig, &config->pitchEnvelopeConfig);
+                voice.bindNoteTables(&next->noteTables);
+                voice.setLFO(&lfo);
+            }
+            for (uint32_t m = allocator.getActiveMask(); m; m &= m - 1) {
+                voices[VoiceAllocator::lowestVoice(m)].refresh(next->operatorChanges, next->pitchEnvelopeChanged);
+            }
+        }
+
+        activeSnapshot.store(next, std::memory_order_release);
+        pendingSnapshot.store(nullptr, std::memory_order_release);
+    }
+
+    // processBlock() body: mono when right is null
+    inline void render(float* out, float* right, size_t n) {
+        float* const blockLeft = out;
+        float* const blockRight = right;
+        const size_t blockSize = n;
+        bool sounding = false;  // Any voice rendered: feeds the effects' tails
+
+        uint32_t now = sampleTime.load(std::memory_order_relaxed);
+        adoptPendingSnapshot();
+        while (n > 0) {
+            const size_t count = applyDueEvents(now, (n < MAX_BLOCK_SIZE) ? n : MAX_BLOCK_SIZE);
+            sounding = sounding || allocator.getActiveMask() != 0;
+            if (config) {
+                renderBlock(out, right, count);
+            } else {
+                for (size_t i = 0; i < count; ++i) out[i] = 0.0f;
+                if (right) {
+                    for (size_t i = 0; i < count; ++i) right[i] = 0.0f;
+                }
+            }
+            out += count;
+            if (right) right += count;
+            n -= count;
+            now += static_cast<uint32_t>(count);
+        }
+        sampleTime.store(now, std::memory_order_relaxed);
+        activeVoiceCount.store(static_cast<uint8_t>(allocator.getActiveCount()), std::memory_order_relaxed);
+
+        effects.process(blockLeft, blockRight, blockSize, sounding);
+    }
+
+    // Apply queued events due at or before sample time now; returns the number of
+    // samples until the next pending event (limit if none comes sooner)
+    size_t applyDueEvents(uint32_t now, size_t limit) {
+        while (const SynthEvent* event = events.peek()) {
+            const int32_t offset = static_cast<int32_t>(event->time - now);  // Wrap-safe
+            if (offset > 0) {
+                return (static_cast<size_t>(offset) < limit) ? static_cast<size_t>(offset) : limit;
+            }
+            applyEvent(*event);
+            events.pop();
+        }
+        return limit;
+    }
+
+    // Render one block (n <= MAX_BLOCK_SIZE) - optimized hot path
+    // All voices run together through the lane renderer, up to the highest active lane
+    // Only live voices are prepared; lanes of idle voices were silenced when they retired
+    // Mono into out, or stereo into out (left) and right when right is not null
+    inline void renderBlock(float* out, float* right, size_t n) {
+        // The limit may have been lowered since the last block (governor, UI)
+        const size_t limit = voiceLimit.load(std::memory_order_relaxed);
+        if (allocator.getActiveCount() > limit) shedVoices(limit);
+
+        // Silence fast path: nothing sounding, only the LFO keeps time
+        if (allocator.getActiveMask() == 0) {
+            controllers.update(params);  // Settle the ramps, nothing to smooth in silence
+            lfo.skipBlock(n);
+            for (size_t i = 0; i < n; ++i) out[i] = 0.0f;
+            if (right) {
+                for (size_t i = 0; i < n; ++i) right[i] = 0.0f;
+            }
+            return;
+        }
+
+        // Control-rate stage: bend and wheel fold into the LFO outputs, only when moved
+        if (controllers.update(params)) {
+            lfo.processBlock(n, controllers.getPrevious(), controllers.getTarget());
+        } else {
+            lfo.processBlock(n);
+        }
+
+        const size_t laneCount = allocator.getLaneCount();
+        const uint32_t released = allocator.getActiveMask() & ~allocator.getHeldMask();
+        uint32_t finished = 0;
+        for (uint32_t m = allocator.getActiveMask(); m; m &= m - 1) {
+            const size_t v = VoiceAllocator::lowestVoice(m);
+            voices[v].prepareLanes(n);
+            if (!voices[v].isActive()) {
+                finished |= 1u << v;  // Envelopes ended: last block
+            } else if (((released >> v) & 1u) && !voices[v].hasRisingCarrier() &&
+                       voices[v].getCarrierGain() < releaseCullGain) {
+                finished |= 1u << v;  // Release tail below the threshold (non-zero L4 never ends)
+                ++culledVoiceCount;
+            }
+        }
+
+        algorithm.renderLanes(config->voiceConfig, lanes, lfo.getAmpModBuffer(), 0, laneCount, n);
+        if (right) {
+            // Both sides in one pass over each output row: two dot products across the
+            // voice lanes, which vectorize like the lane renderer
+#ifdef FIXED_POINT_ENGINE
+            for (size_t i = 0; i < n; ++i) {
+                int64_t left = 0;
+                int64_t rightSum = 0;
+                for (size_t v = 0; v < laneCount; ++v) {
+                    left += static_cast<int64_t>(lanes.output[i][v]) * lanes.panLeft[v];
+                    rightSum += static_cast<int64_t>(lanes.output[i][v]) * lanes.panRight[v];
+                }
+                out[i] = laneSampleToFloat(static_cast<LaneSample>(left >> 24));
+                right[i] = laneSampleToFloat(static_cast<LaneSample>(rightSum >> 24));
+            }
+#else
+            for (size_t i = 0; i < n; ++i) {
+                float left = 0.0f;
+                float rightSum = 0.0f;
+                for (size_t v = 0; v < laneCount; ++v) {
+                    const float sample = laneSampleToFloat(lanes.output[i][v]);
+                    left += sample * lanes.panLeft[v];
+                    rightSum += sample * lanes.panRight[v];
+                }
+                out[i] = left;
+                right[i] = rightSum;
+            }
+#endif
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                LaneSample sum = 0;
+                for (size_t v = 0; v < laneCount; ++v) sum += lanes.output[i][v];
+                out[i] = laneSampleToFloat(sum);
+            }
+        }
+
+        for (; finished; finished &= finished - 1) {
+            const size_t v = VoiceAllocator::lowestVoice(finished);
+            voices[v].silenceLanes();
+            allocator.retire(v);
+        }
+
+        #ifdef DEBUG_PC
+        for (size_t i = 0; i < n; ++i) {
+            if (out[i] > 1.0f || out[i] < -1.0f) {
+                std::cout << "CLIPPING: " << out[i] << std::endl;
+            }
+        }
+        #endif
+        #ifdef DEBUG_TEENSY
+        for (size_t i = 0; i < n; ++i) {
+            if (out[i] > 1.0f || out[i] < -1.0f) {
+                Serial.print(F("CLIPPING: ")); 
+                Serial.println(out[i]);
+            }
+        }
+        #endif
+    }
+
 public:
-    SynthConfig* config = nullptr;  // Non-const since synth can modify it via setters
+    const SynthConfig* config = nullptr;  // Active snapshot's config (audio side, read-only)
     Params params = {};  // Public to allow direct access from UI
-    Synth() = default;
+    Synth() {
+        for (size_t v = 0; v < POLYPHONY; ++v) {
+            voices[v].bindLanes(&lanes, v);
+        }
+        setReleaseCullThreshold(RELEASE_CULL_DEFAULT_DB);
+    }
+
+    // Voices point into this synth's lane storage
+    Synth(const Synth&) = delete;
+    Synth& operator=(const Synth&) = delete;
     
     // Parameters management
     bool initParams(const char* filePath = PARAMS_FILE_PATH) {
@@ -50,6 +432,20 @@ public:
         params.modWheelAssignment.egBias = egBias;
     }
     
+    // Unison: voices stacked per key (1 = off), their detune and stereo spread (0-99)
+    // Applies from the next note
+    void setUnison(uint8_t voiceCount, uint8_t detune, uint8_t spread) {
+        params.unisonVoices = (voiceCount < 1) ? 1 : (voiceCount > UNISON_MAX_VOICES) ? UNISON_MAX_VOICES : voiceCount;
+        params.unisonDetune = (detune > 99) ? 99 : detune;
+        params.unisonSpread = (spread > 99) ? 99 : spread;
+    }
+
+    // Portamento time 0-99 (0 = off), glissando: glide in semitone steps
+    void setPortamento(uint8_t time, bool glissandoOn) {
+        params.portamentoTime = (time > 99) ? 99 : time;
+        params.glissando = glissandoOn;
+    }
+    
     void setMidiChannel(uint8_t channel) {
         params.midiChannel = (channel > 16) ? 16 : channel;
         // Update MidiHandler if registered
@@ -68,134 +464,278 @@ public:
     
     void updateMidiHandlerChannel();
 
+    // Released voices whose carriers' combined gain falls below thresholdDb (dBFS) are
+    // retired; RELEASE_CULL_OFF_DB or lower disables culling
+    void setReleaseCullThreshold(float thresholdDb) {
+        if (thresholdDb > 0.0f) thresholdDb = 0.0f;
+#ifdef FIXED_POINT_ENGINE
+        // 10^(dB / 20) = 2^(dB * log2(10) / 20), from the table-free integer exp2
+        if (thresholdDb <= RELEASE_CULL_OFF_DB) {
+            releaseCullGain = 0;
+            return;
+        }
+        const int32_t octaves = static_cast<int32_t>(thresholdDb * (3.32192809f / 20.0f * Q24_ONE_F));
+        const int64_t mantissa = LUT::exp2FractionQ30(static_cast<int64_t>(octaves & 0xFFFFFF) << 6);  // Q30
+        releaseCullGain = static_cast<LaneSample>(mantissa >> (6 - (octaves >> 24)));
+#else
+        releaseCullGain = (thresholdDb <= RELEASE_CULL_OFF_DB) ? 0.0f : powf(10.0f, thresholdDb / 20.0f);
+#endif
+    }
+
+    uint32_t getCulledVoiceCount() const { return culledVoiceCount; }
+    void resetCulledVoiceCount() { culledVoiceCount = 0; }
+
+    // Runtime polyphony (MIN_VOICE_LIMIT to POLYPHONY); extra voices are shed on the next block
+    // The governor and the limit's writes belong to the control side; the audio side
+    // only loads the limit, and publishes its voice count once per processBlock()
+    void setVoiceLimit(uint8_t limit) {
+        governor.setLimit(limit);
+        voiceLimit.store(governor.getLimit(), std::memory_order_relaxed);
+    }
+
+    uint8_t getVoiceLimit() const { return voiceLimit.load(std::memory_order_relaxed); }
+    uint32_t getShedVoiceCount() const { return shedVoiceCount.load(std::memory_order_relaxed); }
+    // Sounding voices at the end of the last processBlock() (safe from the control side)
+    size_t getActiveVoiceCount() const { return activeVoiceCount.load(std::memory_order_relaxed); }
+
+    // Feed the polyphony governor with the measured audio load (percent of the
+    // deadline, e.g. AudioProcessorUsage()); call periodically from the main loop
+    void reportCpuLoad(float loadPercent) {
+        voiceLimit.store(governor.update(loadPercent, getActiveVoiceCount()), std::memory_order_relaxed);
+    }
+
     void printParams() const {
         params.print();
     }
 
-    // Config management
-    void setFeedback(uint8_t feedback) {
-        if (config) {
-            config->voiceConfig.feedback = feedback;
-        }
-        for (auto& voice : voices) {
-            voice.setFeedback(feedback);
-        }
+    // Synth configuration (control side)
+    // The staging config is copied, so the caller may keep editing it. configure()
+    // loads a preset (voices reset), updateConfig() applies a live edit (sounding
+    // notes continue). Both take effect at the next block boundary; if the previous
+    // publish is still waiting there, they return false and flushConfig() retries
+    bool configure(const SynthConfig* staging) {
+        return requestPublish(staging, true);
     }
 
-    void setAlgorithm(const AlgorithmConfig* algorithmConfig) {
-        if (config) {
-            config->voiceConfig.algorithm = algorithmConfig;
-        }
-        for (auto& voice : voices) {
-            voice.setAlgorithm(algorithmConfig);
-        }
+    bool updateConfig(const SynthConfig* staging) {
+        return requestPublish(staging, false);
     }
 
-    void setOSCKeySync(bool sync) {
-        for (auto& voice : voices) {
-            voice.setOSCKeySync(sync);
-        }
+    // Publish a config refused earlier; call from the control loop
+    bool flushConfig() {
+        if (!deferredConfig) return true;
+        if (!publish(deferredConfig, deferredReset)) return false;
+        deferredConfig = nullptr;
+        deferredReset = false;
+        return true;
     }
 
-    // Synth configuration
-    void configure(SynthConfig* synthConfigPtr) {
-        config = synthConfigPtr;
-        lfo.configure(&config->lfoConfig);
-        
-        for (auto& voice : voices) {
-            voice.configure(&config->voiceConfig);
-            voice.setPitchEnvelopeConfig(&config->pitchEnvelopeConfig);
-            voice.setLFO(&lfo);
-        }
+    // Replace the key frequencies (control side); published with the last staging
+    // config as a live edit, so held notes move to the new pitch
+    // Same return and retry rules as updateConfig()
+    bool setTuning(const TuningTable& table) {
+        tuning = table;
+        ++tuningVersion;
+        return stagingConfig ? requestPublish(stagingConfig, false) : true;
+    }
+
+    // Load a Scala scale and optional keyboard mapping (SD card on Teensy, disk on PC)
+    // False if the scale is missing or malformed: the current tuning stays
+    bool loadTuning(const char* sclPath = TUNING_SCL_PATH, const char* kbmPath = TUNING_KBM_PATH) {
+        TuningTable table;
+        if (!table.loadFiles(sclPath, kbmPath)) return false;
+        return setTuning(table);
+    }
+
+    const TuningTable& getTuning() const { return tuning; }
+
+    // Post-voice effects chain (control side setters, see FxChain)
+    FxChain& getEffects() { return effects; }
+    const FxChain& getEffects() const { return effects; }
+
+    // Version of the config the audio side is playing (0 = none yet)
+    uint32_t getConfigVersion() const {
+        const SynthSnapshot* active = activeSnapshot.load(std::memory_order_acquire);
+        return active ? active->version : 0;
     }
 
+    // Note events (audio side); called directly, they pick up a published config first
     void noteOn(uint8_t midiNote, uint8_t velocity = 100) {
+        adoptPendingSnapshot();
         if (!config) return; 
 
-        // Monophonic mode
+        // Portamento starts from the pitch of the latest note (mid-glide if still moving)
+        const bool glide = portamentoActive() && lastVoice >= 0;
+        const VoicePitch glideStart = glide ? voices[static_cast<size_t>(lastVoice)].getPitch() : 0;
+
+        const size_t limit = voiceLimit.load(std::memory_order_relaxed);
+        const size_t count = unisonCount(limit);
+
+        // Monophonic mode: voice 0 (voices 0 to count-1 in unison); a key pressed while
+        // another is held plays legato
         if (config->monophonic) {
-            for (auto& voice : voices) {
-                voice.noteOff();
+            const uint32_t unisonMask = (1u << count) - 1u;
+            for (uint32_t m = allocator.getHeldMask() & ~unisonMask; m; m &= m - 1) {
+                const size_t v = VoiceAllocator::lowestVoice(m);
+                voices[v].noteOff();
+                allocator.releaseVoice(v);
             }
-            lfo.trigger();
-            voices[0].noteOn(midiNote, velocity);
+            const bool legato = !monoNotes.empty() && (allocator.getActiveMask() & unisonMask) == unisonMask;
+            monoNotes.push(midiNote);
+            if (!legato) lfo.trigger();
+            for (size_t v = 0; v < count; ++v) {
+                allocator.assign(v, midiNote);
+                if (legato) {
+                    voices[v].legato(midiNote);
+                } else {
+                    placeVoice(v, v, count);
+                    voices[v].noteOn(midiNote, velocity);
+                }
+                if (glide) startGlide(v, glideStart);
+            }
+            lastVoice = 0;
             return;
         }
 
-        // Find free voice
-        for (size_t i = 0; i < POLYPHONY; ++i) {
-            if (!voices[i].isActive()) {
-                voiceAge[i] = globalAgeCounter++;
-                voices[i].noteOn(midiNote, velocity);
-                ++activeNoteCount;
-                
-                if (activeNoteCount == 1 || config->lfoConfig.LFOKeySync) {
-                    lfo.trigger();
-                }
-                return;
-            }
+        // Same key again while still held: release its voices, the new note gets its own
+        for (uint32_t m = allocator.release(midiNote); m; m &= m - 1) {
+            voices[VoiceAllocator::lowestVoice(m)].noteOff();
         }
 
-        // Voice stealing: find oldest
-        size_t oldestIndex = 0;
-        uint64_t oldestAge = voiceAge[0];
-        
-        for (size_t i = 1; i < POLYPHONY; ++i) {
-            if (voiceAge[i] < oldestAge) {
-                oldestAge = voiceAge[i];
-                oldestIndex = i;
-            }
+        const bool firstKey = allocator.getHeldMask() == 0;
+        for (size_t index = 0; index < count; ++index) {
+            bool stolen;
+            const size_t v = allocator.allocate(midiNote, stolen, limit);
+            if (stolen) voices[v].noteOff();
+            placeVoice(v, index, count);
+            voices[v].noteOn(midiNote, velocity);
+            if (glide) startGlide(v, glideStart);
+            if (index == 0) lastVoice = static_cast<int>(v);
         }
 
-        voices[oldestIndex].noteOff();
-        voiceAge[oldestIndex] = globalAgeCounter++;
-        voices[oldestIndex].noteOn(midiNote, velocity);
+        if (firstKey || config->lfoConfig.LFOKeySync) {
+            lfo.trigger();
+        }
     }
 
     void noteOff(uint8_t midiNote) {
+        adoptPendingSnapshot();
         if (!config) return; 
 
         if (config->monophonic) {
-            voices[0].noteOff();
-            return;
-        }
+            const bool sounding = !monoNotes.empty() && monoNotes.top() == midiNote;
+            if (!monoNotes.remove(midiNote) || !sounding) return;
 
-        for (auto& voice : voices) {
-            if (voice.isActive() && voice.getCurrentMidiNote() == midiNote) {
-                voice.noteOff();
-                --activeNoteCount;
+            // Back to the latest key still held, legato
+            if (!monoNotes.empty() && allocator.isActive(0)) {
+                const VoicePitch glideStart = voices[0].getPitch();
+                for (uint32_t m = allocator.getHeldMask(); m; m &= m - 1) {
+                    const size_t v = VoiceAllocator::lowestVoice(m);
+                    allocator.assign(v, monoNotes.top());
+                    voices[v].legato(monoNotes.top());
+                    if (portamentoActive()) startGlide(v, glideStart);
+                }
                 return;
             }
+            allNotesOff();
+            return;
+        }
+
+        for (uint32_t m = allocator.release(midiNote); m; m &= m - 1) {
+            voices[VoiceAllocator::lowestVoice(m)].noteOff();
         }
     }
 
-    // Process one sample - optimized hot path
-    inline float process() {
-        if (!config) return 0.0f; 
+    void controlChange(uint8_t controller, uint8_t value) {
+        switch (controller) {
+            case 1:    // Modulation wheel
+                controllers.setModWheel(value);
+                break;
+            case 5:    // Portamento time (0-127 onto 0-99)
+                params.portamentoTime = static_cast<uint8_t>(value * 99 / 127);
+                break;
+            case 65:   // Portamento on/off switch
+                controllers.setPortamentoSwitch(value >= 64);
+                break;
+            case 94:   // Celeste (detune) depth: unison detune (0-127 onto 0-99)
+                params.unisonDetune = static_cast<uint8_t>(value * 99 / 127);
+                break;
+            case 121:  // Reset all controllers
+                controllers.reset();
+                break;
+            case 120:  // All sound off
+            case 123:  // All notes off
+                allNotesOff();
+                break;
+            default:
+                break;
+        }
+    }
 
-        lfo.process();
+    void setPitchBend(uint16_t value) {
+        controllers.setPitchBend(value);
+    }
 
-        float sample = 0.0f;
-        for (auto& voice : voices) {
-            if (voice.isActive()) {
-                sample += voice.process();
-            }
-        }
+    uint16_t getPitchBend() const { return controllers.getPitchBend(); }
+    uint8_t getModWheel() const { return controllers.getModWheel(); }
 
-        #ifdef DEBUG_PC
-        if(sample > 1.0f || sample < -1.0f) {
-            std::cout << "CLIPPING: " << sample << std::endl;
-        }
-        #endif
-        #ifdef DEBUG_TEENSY
-        if(sample > 1.0f || sample < -1.0f) {
-            Serial.print(F("CLIPPING: ")); 
-            Serial.println(sample);
+    void allNotesOff() {
+        monoNotes.clear();
+        for (uint32_t m = allocator.getHeldMask(); m; m &= m - 1) {
+            const size_t v = VoiceAllocator::lowestVoice(m);
+            voices[v].noteOff();
+            allocator.releaseVoice(v);
         }
-        #endif
+    }
+
+    // Event queue, control side (single producer): the event is applied when the
+    // audio side reaches event.time; times already past apply at the next block
+    // Returns false if the queue is full
+    bool postEvent(const SynthEvent& event) {
+        return events.push(event);
+    }
+
+    // Sample time of the audio side, the clock of SynthEvent::time
+    uint32_t getSampleTime() const {
+        return sampleTime.load(std::memory_order_relaxed);
+    }
 
+    // Render n samples of mono output - optimized hot path
+    // Per-block work (LFO setup, voice activity scan, config loads) runs once per
+    // MAX_BLOCK_SIZE samples instead of once per sample. Queued events are applied
+    // at their sample time: the block is split at event offsets. The effects chain
+    // then runs once over the whole call
+    inline void processBlock(float* out, size_t n) {
+        render(out, nullptr, n);
+    }
+
+    // Render n samples of planar stereo output: voices are placed by their pan
+    // (unison spread), centred voices give left = right = the mono output
+    inline void processBlock(float* left, float* right, size_t n) {
+        render(left, right, n);
+    }
+
+    // No voice is sounding, no event or config is waiting and no effect tail is
+    // ringing: the next block would be silent
+    bool isIdle() const {
+        return allocator.getActiveMask() == 0 && events.empty() &&
+               !pendingSnapshot.load(std::memory_order_acquire) && effects.isIdle();
+    }
+
+    // Advance n samples of silence without rendering (caller checked isIdle())
+    // Keeps the free-running LFO and the sample clock in time for the next note
+    inline void skipBlock(size_t n) {
+        lfo.skipBlock(n);
+        sampleTime.store(getSampleTime() + static_cast<uint32_t>(n), std::memory_order_relaxed);
+    }
+
+    // Process one sample (thin wrapper over processBlock)
+    inline float process() {
+        float sample;
+        processBlock(&sample, 1);
         return sample;
     }
+
 };
 
 // Include MidiHandler for implementation
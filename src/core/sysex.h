@@ -12,6 +12,7 @@
     #include <SD.h>
 #else
     #include <fstream>
+    #include <filesystem>
 #endif
 
 #ifdef DEBUG_PC
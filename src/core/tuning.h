@@ -0,0 +1,263 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef PLATFORM_TEENSY
+    #include <SD.h>
+#else
+    #include <cstdio>
+#endif
+
+#include "constants.h"
+
+// Frequency of every MIDI key: 12-TET by default, or a Scala scale (.scl) with an
+// optional keyboard mapping (.kbm), as in msfa tuning.h
+// Synth turns the table into its note-on tables on the control side (Synth::setTuning),
+// so a tuning is swapped with a config snapshot and costs nothing at note-on
+struct TuningTable {
+    float frequency[128];  // Hz per MIDI key
+#ifdef FIXED_POINT_ENGINE
+    uint32_t phaseIncrement[128];  // Per-sample phase step of each key (one cycle = 2^32)
+#endif
+
+    TuningTable() { setStandard(); }
+
+    // 12-TET, A4 (key 69) = 440 Hz
+    static inline float standardFrequency(uint8_t midiNote) {
+        return 13.75f * exp2f((static_cast<float>(midiNote) - 9.0f) / 12.0f);
+    }
+
+#ifdef FIXED_POINT_ENGINE
+    // 12-TET phase increment in integer: A-1 (13.75 Hz) with 8 extra bits, times the
+    // semitone ratio, shifted by the octave
+    static inline uint32_t standardPhaseIncrement(uint8_t midiNote) {
+        const uint64_t base = (uint64_t(55) << 40) / static_cast<uint64_t>(4.0f * SAMPLE_RATE);
+        const int key = static_cast<int>(midiNote & 0x7F) + 3;  // Semitones above A-2 (A-1 = octave 1)
+        const int shift = 9 - key / 12;  // The 8 extra bits, less one per octave above A-1
+        const uint64_t increment = (base * SEMITONE_RATIO_Q30[key % 12]) >> 30;
+        return static_cast<uint32_t>((shift > 0) ? (increment + (uint64_t(1) << (shift - 1))) >> shift
+                                                 : increment << -shift);
+    }
+
+    // Phase increment of a frequency from a tuning file (one rounding step, 20 kHz at most
+    // like Oscillator::setFrequency)
+    static inline uint32_t phaseIncrementOf(double frequencyHz) {
+        if (frequencyHz > 20000.0) frequencyHz = 20000.0;
+        return static_cast<uint32_t>(frequencyHz * (4294967296.0 / static_cast<double>(SAMPLE_RATE)) + 0.5);
+    }
+#endif
+
+    void setStandard() {
+        for (uint8_t note = 0; note < 128; ++note) {
+            frequency[note] = standardFrequency(note);
+#ifdef FIXED_POINT_ENGINE
+            phaseIncrement[note] = standardPhaseIncrement(note);
+#endif
+        }
+    }
+
+    // Parse Scala data: scl is required, kbm may be nullptr (linear mapping, degree 0
+    // on key 60, key 69 at 440 Hz). Keys outside the mapping's range or unmapped ('x')
+    // keep their 12-TET frequency. Returns false (table unchanged) on malformed data
+    bool loadScala(const char* scl, size_t sclLength, const char* kbm = nullptr, size_t kbmLength = 0) {
+        Scale scale;
+        KeyboardMap map;
+        if (!parseScale(scl, sclLength, scale)) return false;
+        if (kbm && !parseKeyboardMap(kbm, kbmLength, scale.count, map)) return false;
+
+        const double referenceCents = keyCents(map.referenceKey, scale, map);
+        for (int note = 0; note < 128; ++note) {
+            frequency[note] = standardFrequency(static_cast<uint8_t>(note));
+#ifdef FIXED_POINT_ENGINE
+            phaseIncrement[note] = standardPhaseIncrement(static_cast<uint8_t>(note));
+#endif
+            if (note < map.firstKey || note > map.lastKey || !isMapped(note, map)) continue;
+            const double cents = keyCents(note, scale, map) - referenceCents;
+            const double frequencyHz = map.referenceFrequency * std::pow(2.0, cents / 1200.0);
+            frequency[note] = static_cast<float>(frequencyHz);
+#ifdef FIXED_POINT_ENGINE
+            phaseIncrement[note] = phaseIncrementOf(frequencyHz);
+#endif
+        }
+        return true;
+    }
+
+    // Load a .scl file, and a .kbm file if kbmPath names one that exists, from SD
+    // (Teensy) or disk (PC)
+    bool loadFiles(const char* sclPath, const char* kbmPath = nullptr) {
+        static char sclData[TUNING_FILE_MAX_SIZE];
+        static char kbmData[TUNING_FILE_MAX_SIZE];
+        const size_t sclLength = readFile(sclPath, sclData);
+        if (sclLength == 0) return false;
+        const size_t kbmLength = kbmPath ? readFile(kbmPath, kbmData) : 0;
+        return loadScala(sclData, sclLength, kbmLength ? kbmData : nullptr, kbmLength);
+    }
+
+private:
+    struct Scale {
+        double cents[TUNING_MAX_DEGREES + 1] = {0.0};  // cents[0] = 0, cents[count] = period
+        int count = 0;
+    };
+
+    struct KeyboardMap {
+        int size = 0;  // 0 = linear: each key the next degree
+        int firstKey = 0;
+        int lastKey = 127;
+        int middleKey = 60;  // Key of scale degree 0
+        int referenceKey = 69;
+        double referenceFrequency = 440.0;
+        int octaveDegree = 0;  // Degree of the formal octave, 0 = the scale's period
+        int degrees[TUNING_MAX_DEGREES] = {0};  // -1 = unmapped key
+    };
+
+    // Line reader over a text buffer, skipping '!' comments
+    struct Lines {
+        const char* data;
+        size_t length;
+        size_t position = 0;
+
+        Lines(const char* text, size_t size) : data(text), length(size) {}
+
+        // Next non-comment line (not null-terminated: ends at *end)
+        bool next(const char*& begin, const char*& end) {
+            while (position < length) {
+                begin = data + position;
+                while (position < length && data[position] != '\n') ++position;
+                end = data + position;
+                if (position < length) ++position;
+                if (end > begin && end[-1] == '\r') --end;
+                if (begin < end && *begin == '!') continue;
+                return true;
+            }
+            return false;
+        }
+    };
+
+    // First whitespace-delimited token of [begin, end), copied and null-terminated
+    static bool token(const char* begin, const char* end, char* out, size_t outSize) {
+        while (begin < end && (*begin == ' ' || *begin == '\t')) ++begin;
+        size_t n = 0;
+        while (begin < end && *begin != ' ' && *begin != '\t' && n + 1 < outSize) out[n++] = *begin++;
+        out[n] = '\0';
+        return n > 0;
+    }
+
+    static bool parseInt(const char* begin, const char* end, int& value) {
+        char text[32];
+        if (!token(begin, end, text, sizeof(text))) return false;
+        char* stop;
+        value = static_cast<int>(strtol(text, &stop, 10));
+        return *stop == '\0';
+    }
+
+    // Scale degree: cents if it contains a '.', otherwise a ratio "n/d" or "n"
+    static bool parsePitch(const char* begin, const char* end, double& cents) {
+        char text[64];
+        if (!token(begin, end, text, sizeof(text))) return false;
+        char* stop;
+        if (strchr(text, '.')) {
+            cents = strtod(text, &stop);
+            return *stop == '\0';
+        }
+        const double numerator = static_cast<double>(strtol(text, &stop, 10));
+        double denominator = 1.0;
+        if (*stop == '/') denominator = static_cast<double>(strtol(stop + 1, &stop, 10));
+        if (*stop != '\0' || numerator <= 0.0 || denominator <= 0.0) return false;
+        cents = 1200.0 * std::log2(numerator / denominator);
+        return true;
+    }
+
+    static bool parseScale(const char* scl, size_t length, Scale& scale) {
+        Lines lines(scl, length);
+        const char* begin;
+        const char* end;
+        if (!lines.next(begin, end)) return false;  // Description (may be empty)
+        if (!lines.next(begin, end) || !parseInt(begin, end, scale.count)) return false;
+        if (scale.count < 1 || scale.count > TUNING_MAX_DEGREES) return false;
+        for (int i = 1; i <= scale.count; ++i) {
+            if (!lines.next(begin, end) || !parsePitch(begin, end, scale.cents[i])) return false;
+        }
+        return true;
+    }
+
+    static bool parseKeyboardMap(const char* kbm, size_t length, int scaleCount, KeyboardMap& map) {
+        Lines lines(kbm, length);
+        const char* begin;
+        const char* end;
+        char text[32];
+        if (!lines.next(begin, end) || !parseInt(begin, end, map.size)) return false;
+        if (!lines.next(begin, end) || !parseInt(begin, end, map.firstKey)) return false;
+        if (!lines.next(begin, end) || !parseInt(begin, end, map.lastKey)) return false;
+        if (!lines.next(begin, end) || !parseInt(begin, end, map.middleKey)) return false;
+        if (!lines.next(begin, end) || !parseInt(begin, end, map.referenceKey)) return false;
+        if (!lines.next(begin, end) || !token(begin, end, text, sizeof(text))) return false;
+        map.referenceFrequency = strtod(text, nullptr);
+        if (!lines.next(begin, end) || !parseInt(begin, end, map.octaveDegree)) return false;
+        if (map.size < 0 || map.size > TUNING_MAX_DEGREES || map.referenceFrequency <= 0.0 ||
+            map.octaveDegree < 0 || map.octaveDegree > scaleCount) {
+            return false;
+        }
+        for (int i = 0; i < map.size; ++i) {
+            if (!lines.next(begin, end) || !token(begin, end, text, sizeof(text))) return false;
+            if (text[0] == 'x' || text[0] == 'X') {
+                map.degrees[i] = -1;
+            } else if (!parseInt(begin, end, map.degrees[i]) || map.degrees[i] < 0) {
+                return false;
+            }
+        }
+        return map.referenceKey >= 0 && map.referenceKey < 128 && isMapped(map.referenceKey, map);
+    }
+
+    // Rounds toward minus infinity: keys below the middle key fall in negative octaves
+    static int floorDiv(int a, int b) { return (a >= 0) ? a / b : -((-a + b - 1) / b); }
+
+    static bool isMapped(int note, const KeyboardMap& map) {
+        if (map.size == 0) return true;
+        const int offset = note - map.middleKey;
+        return map.degrees[offset - floorDiv(offset, map.size) * map.size] >= 0;
+    }
+
+    // Pitch of a key in cents above the middle key's degree 0
+    static double keyCents(int note, const Scale& scale, const KeyboardMap& map) {
+        const double period = scale.cents[scale.count];
+        const int offset = note - map.middleKey;
+        int degree = offset;
+        double octaves = 0.0;
+        if (map.size > 0) {
+            const int mapOctave = floorDiv(offset, map.size);
+            degree = map.degrees[offset - mapOctave * map.size];
+            const double formalOctave = map.octaveDegree ? scale.cents[map.octaveDegree] : period;
+            octaves = mapOctave * formalOctave;
+        }
+        const int cycle = floorDiv(degree, scale.count);
+        return octaves + cycle * period + scale.cents[degree - cycle * scale.count];
+    }
+
+    // Whole file into buffer (size TUNING_FILE_MAX_SIZE); 0 if missing, empty or too large
+    static size_t readFile(const char* path, char* buffer) {
+        #ifdef PLATFORM_TEENSY
+        File file = SD.open(path);
+        if (!file) return 0;
+        const size_t size = file.size();
+        size_t bytesRead = 0;
+        if (size > 0 && size <= TUNING_FILE_MAX_SIZE) {
+            bytesRead = file.read(reinterpret_cast<uint8_t*>(buffer), size);
+        }
+        file.close();
+        return (bytesRead == size) ? bytesRead : 0;
+        #else
+        FILE* file = fopen(path, "rb");
+        if (!file) return 0;
+        const size_t bytesRead = fread(buffer, 1, TUNING_FILE_MAX_SIZE, file);
+        const bool complete = feof(file) != 0;
+        fclose(file);
+        return complete ? bytesRead : 0;
+        #endif
+    }
+};
+
+#endif // TUNING_H
@@ -7,7 +7,26 @@
 #include "lfo.h"
 #include "pitchenv.h"
 
+#ifdef FIXED_POINT_ENGINE
+typedef int32_t VoicePitch;  // Semitones in Q24 (integer engine)
+#else
+typedef float VoicePitch;    // Semitones
+#endif
+
+// Note-on tables of a preset ("compiled voice"), shared by all voices playing it
+// Rebuild with build() whenever the operator configs or the tuning change
+struct VoiceNoteTables {
+    OperatorNoteTable operators[NUM_OPERATORS];
+
+    void build(const VoiceConfig& voiceConfig, const TuningTable& tuning) {
+        for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+            Operator::buildNoteTable(voiceConfig.operatorConfigs[i], tuning, operators[i]);
+        }
+    }
+};
+
 // Single FM voice (monophonic) - manages 6 operators + algorithm
+// View over one lane of the shared VoiceLanes storage (bindLanes() before use)
 class Voice {
 private:
     std::array<Operator, NUM_OPERATORS> operators = {};
@@ -16,10 +35,72 @@ private:
     
     const VoiceConfig* config = nullptr;
     LFO* lfo = nullptr;
+    VoiceLanes* lanes = nullptr;
+    size_t lane = 0;
     uint8_t currentMidiNote = 0;
     
+    // Portamento: distance to the key in semitones, run down by glideRate per sample
+    VoicePitch glideOffset = 0;
+    VoicePitch glideRate = 0;
+    bool glissando = false;  // Glide in semitone steps
+    VoicePitch detune = 0;   // Fixed pitch offset in semitones (unison)
+    
+    LaneSample silentAmpModBuffer[MAX_BLOCK_SIZE] = {0};  // Used when no LFO is attached
+    
+    // Key of the current note after transpose (the operators' note table index)
+    uint8_t transposedNote() const {
+        int note = static_cast<int>(currentMidiNote) + static_cast<int>(config->transpose) - 24;
+        if (note < 0) note = 0;
+        else if (note > 127) note = 127;
+        return static_cast<uint8_t>(note);
+    }
+
+    // Retune the operators to the current glide position plus the detune (once per
+    // block while gliding)
+    void applyGlide() {
+#ifdef FIXED_POINT_ENGINE
+        const int32_t semitoneSteps = (glideOffset + (1 << 23)) & ~0xFFFFFF;  // Nearest semitone
+        const int32_t octaves = ((glissando ? semitoneSteps : glideOffset) + detune) / 12;
+        for (auto& op : operators) {
+            op.setPitchOffset(octaves);
+        }
+#else
+        const float offset = (glissando ? roundf(glideOffset) : glideOffset) + detune;
+        const float ratio = (offset == 0.0f) ? 1.0f : exp2f(offset * (1.0f / 12.0f));
+        for (auto& op : operators) {
+            op.setPitchRatio(ratio);
+        }
+#endif
+    }
+
+    void advanceGlide(size_t n) {
+        const VoicePitch distance = glideRate * static_cast<VoicePitch>(n);
+        if (glideOffset > 0) {
+            glideOffset = (glideOffset > distance) ? glideOffset - distance : 0;
+        } else {
+            glideOffset = (-glideOffset > distance) ? glideOffset + distance : 0;
+        }
+        applyGlide();
+    }
+
 public:
     Voice() = default;
+
+    // Attach this voice and its operators to one lane of the lane storage
+    void bindLanes(VoiceLanes* voiceLanes, size_t laneIndex) {
+        lanes = voiceLanes;
+        lane = laneIndex;
+        for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+            operators[i].bindLane(&lanes->operators[i], lane);
+        }
+    }
+    
+    // Trigger operators from precomputed tables (built from this voice's config)
+    void bindNoteTables(const VoiceNoteTables* tables) {
+        for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+            operators[i].bindNoteTable(tables ? &tables->operators[i] : nullptr);
+        }
+    }
     
     void configure(const VoiceConfig* voiceConfig) {
         if (!voiceConfig || !voiceConfig->algorithm) return;
@@ -36,7 +117,6 @@ public:
         }
         
         algorithm.setConfig(config->algorithm);
-        algorithm.setFeedback(config->feedback);
         reset();
     }
 
@@ -48,44 +128,83 @@ public:
         lfo = lfoPtr;
     }
     
-    void updateConfig(const VoiceConfig* voiceConfig) {
-        if (!voiceConfig) return;
+    // Switch to a new config without resetting the voice (config snapshot swap)
+    // A sounding note carries on; the new values apply from the next note or envelope stage
+    void updateConfig(const VoiceConfig* voiceConfig, const PitchEnvelopeConfig* peConfig) {
+        if (!voiceConfig || !voiceConfig->algorithm) return;
         config = voiceConfig;
         
         for (size_t i = 0; i < NUM_OPERATORS; ++i) {
-            operators[i].setConfig(&config->operatorConfigs[i]);
+            operators[i].replaceConfig(&config->operatorConfigs[i]);
         }
         
         algorithm.setConfig(config->algorithm);
-        algorithm.setFeedback(config->feedback);
-    }
-
-    void setFeedback(uint8_t feedbackValue) {
-        algorithm.setFeedback(feedbackValue);
+        pitchEnv.replaceConfig(peConfig);
     }
     
-    void setAlgorithm(const AlgorithmConfig* algorithmConfig) {
-        algorithm.setConfig(algorithmConfig);
-    }
-
-    void setOSCKeySync(bool sync) {
+    void noteOn(uint8_t midiNote, uint8_t velocity = 100) {
         if (!config) return;
-        for (size_t i = 0; i < NUM_OPERATORS; i++) {
-            const_cast<OperatorConfig*>(&config->operatorConfigs[i])->OSCKeySync = sync;
-        }
+    
+        currentMidiNote = midiNote;
+        glideOffset = 0;
+        algorithm.triggerAll(transposedNote(), velocity);
+        pitchEnv.trigger();
+        if (detune != 0) applyGlide();
     }
     
-    void noteOn(uint8_t midiNote, uint8_t velocity = 100) {
+    // Monophonic legato: move the sounding note to another key, envelopes carry on
+    void legato(uint8_t midiNote) {
         if (!config) return;
-    
         currentMidiNote = midiNote;
+        glideOffset = 0;
+        const uint8_t note = transposedNote();
+        for (auto& op : operators) {
+            op.refresh(OperatorChange::FREQUENCY | OperatorChange::LEVEL, note);
+        }
+        if (detune != 0) applyGlide();
+    }
 
-        int note = static_cast<int>(midiNote) + static_cast<int>(config->transpose) - 24;
-        if (note < 0) note = 0;
-        else if (note > 127) note = 127;
+    // Glide into the current note from fromPitch (semitones, see getPitch()) at rate
+    // semitones per sample, in semitone steps if steps is set
+    void glideFrom(VoicePitch fromPitch, VoicePitch rate, bool steps) {
+        glideOffset = (rate > 0) ? fromPitch - notePitch() : 0;
+        glideRate = rate;
+        glissando = steps;
+        if (glideOffset != 0) applyGlide();
+    }
 
-        algorithm.triggerAll(static_cast<uint8_t>(note), velocity);
-        pitchEnv.trigger();
+    // Pitch of the current MIDI note in semitones
+    VoicePitch notePitch() const {
+#ifdef FIXED_POINT_ENGINE
+        return static_cast<VoicePitch>(currentMidiNote) << 24;
+#else
+        return static_cast<float>(currentMidiNote);
+#endif
+    }
+
+    // Pitch being played in semitones (MIDI note plus glide), where the next glide starts
+    VoicePitch getPitch() const { return notePitch() + glideOffset; }
+
+    // Unison placement, set before noteOn(): pitch offset in semitones, and stereo
+    // position from -1 (left) to 1 (right). Balance law: the centre keeps both sides
+    // at unity, so centred voices mix to left = right = the mono output
+    void setDetune(VoicePitch semitones) { detune = semitones; }
+
+    void setPan(LaneSample pan) {
+        lanes->panLeft[lane] = (pan > 0) ? LANE_ONE - pan : LANE_ONE;
+        lanes->panRight[lane] = (pan < 0) ? LANE_ONE + pan : LANE_ONE;
+    }
+
+    // Carry a live edit over to the sounding note (after updateConfig()): operators
+    // recompute the changed values only (OperatorChange flags per operator)
+    void refresh(const uint8_t* operatorChanges, bool pitchEnvelopeChanged) {
+        if (!config) return;
+        const uint8_t note = transposedNote();
+        for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+            if (operatorChanges[i]) operators[i].refresh(operatorChanges[i], note);
+        }
+        if (detune != 0 || glideOffset != 0) applyGlide();  // Refreshed frequencies are on the key
+        if (pitchEnvelopeChanged) pitchEnv.refresh();
     }
     
     void noteOff() {
@@ -93,20 +212,66 @@ public:
         pitchEnv.release();
     }
 
-    // Process one sample - optimized hot path
-    inline float process() {
-        float pitchMod = pitchEnv.process();
-        float ampMod = 0.0f;
-        
+    // Process a block (n <= MAX_BLOCK_SIZE) for this voice alone - single-lane render
+    // The shared LFO must already have processed the same block
+    inline void processBlock(float* out, size_t n) {
+        if (!config) {
+            for (size_t i = 0; i < n; ++i) out[i] = 0.0f;
+            return;
+        }
+        prepareLanes(n);
+        algorithm.renderLanes(*config, *lanes, lfo ? lfo->getAmpModBuffer() : silentAmpModBuffer, lane, lane + 1, n);
+        for (size_t i = 0; i < n; ++i) out[i] = laneSampleToFloat(lanes->output[i][lane]);
+    }
+
+    // Prepare this voice's lane for Algorithm::renderLanes (n <= MAX_BLOCK_SIZE):
+    // pitch modulation column and operator gain ramps
+    // The shared LFO must already have processed the same block
+    inline void prepareLanes(size_t n) {
+        if (glideOffset != 0) advanceGlide(n);
+#ifdef FIXED_POINT_ENGINE
+        // Pitch envelope and LFO offsets add in octaves, one exp2 makes the multiplier
+        // (capped below the 7 octaves a Q24 multiplier holds)
+        const LFOPitch* lfoPitchMod = lfo ? lfo->getPitchModBuffer() : nullptr;
+        for (size_t i = 0; i < n; ++i) {
+            int32_t octaves = pitchEnv.processLog() + (lfoPitchMod ? lfoPitchMod[i] : 0);
+            if (octaves >= (7 << 24)) octaves = (7 << 24) - 1;
+            lanes->pitchMod[i][lane] = LUT::exp2Q24(octaves);
+        }
+#else
         if (lfo) {
-            pitchMod *= lfo->getPitchMod();
-            ampMod = lfo->getAmpMod();
+            const float* lfoPitchMod = lfo->getPitchModBuffer();
+            for (size_t i = 0; i < n; ++i) {
+                lanes->pitchMod[i][lane] = lanePitch(pitchEnv.process() * lfoPitchMod[i]);
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                lanes->pitchMod[i][lane] = lanePitch(pitchEnv.process());
+            }
         }
-        
-        return algorithm.process(pitchMod, ampMod);
+#endif
+        for (auto& op : operators) {
+            op.prepareBlock(n);
+        }
+    }
+
+    // Keep an inactive voice's lane silent and its phases frozen
+    inline void silenceLanes() {
+        for (auto& op : operators) {
+            op.silenceLane();
+        }
+    }
+
+    // Process one sample (thin wrapper over processBlock)
+    inline float process() {
+        float out;
+        processBlock(&out, 1);
+        return out;
     }
+
     
     void reset() {
+        glideOffset = 0;
         algorithm.resetAll();
         pitchEnv.reset();
         for (auto& op : operators) {
@@ -116,6 +281,29 @@ public:
 
     uint8_t getCurrentMidiNote() const { return currentMidiNote; }
 
+    // Upper bound of the voice's output amplitude: sum of its carriers' gains
+    LaneSample getCarrierGain() const {
+        if (!config || !config->algorithm) return 0;
+        LaneSample gain = 0;
+        for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+            if (config->algorithm->isCarrier[i]) gain += operators[i].getOutputGain();
+        }
+#ifdef FIXED_POINT_ENGINE
+        return gain >> FIXED_OPERATOR_SHIFT;
+#else
+        return gain * OPERATOR_SCALING;
+#endif
+    }
+
+    // A carrier's gain is still climbing (getCarrierGain() is not yet a bound for the tail)
+    bool hasRisingCarrier() const {
+        if (!config || !config->algorithm) return false;
+        for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+            if (config->algorithm->isCarrier[i] && operators[i].isRising()) return true;
+        }
+        return false;
+    }
+
     bool isActive() const {
         for (const auto& op : operators) {
             if (op.isActive()) return true;
@@ -0,0 +1,116 @@
+#ifndef VOICE_ALLOCATOR_H
+#define VOICE_ALLOCATOR_H
+
+#include <array>
+#include "constants.h"
+
+static_assert(POLYPHONY <= 32, "Voice masks are 32 bits wide");
+
+// Voice bookkeeping for Synth: which voices are sounding, which keys hold them
+// Voice indices live in bitmasks (bit v = voice v), so finding a free voice or
+// walking the live ones is a count-trailing-zeros, and a note->voices map makes
+// note-off a table lookup (several voices per key in unison mode). Synth updates
+// it on note events and when a voice's envelopes have all finished (retire),
+// never per sample
+class VoiceAllocator {
+private:
+    static constexpr uint32_t ALL_VOICES = (POLYPHONY == 32) ? 0xFFFFFFFFu : ((1u << POLYPHONY) - 1u);
+
+    uint32_t activeMask = 0;  // Voices with a running envelope (held or releasing)
+    uint32_t heldMask = 0;    // Voices whose key is still down
+    std::array<uint32_t, 128> noteVoices;       // Held voices playing each MIDI note
+    std::array<uint8_t, POLYPHONY> voiceNote;   // Note of each held voice
+    std::array<uint64_t, POLYPHONY> voiceAge;   // Allocation order, for stealing
+    uint64_t ageCounter = 0;
+
+public:
+    VoiceAllocator() { reset(); }
+
+    void reset() {
+        activeMask = 0;
+        heldMask = 0;
+        ageCounter = 0;
+        noteVoices.fill(0);
+        voiceNote.fill(0);
+        voiceAge.fill(0);
+    }
+
+    // Pick the voice for a new note: the lowest free voice (keeps the lane range
+    // short), otherwise - all voices or voiceLimit of them sounding - the oldest
+    // voice is stolen. Sets stolen when the returned voice was sounding
+    size_t allocate(uint8_t midiNote, bool& stolen, size_t voiceLimit = POLYPHONY) {
+        size_t v;
+        const uint32_t freeMask = ~activeMask & ALL_VOICES;
+        if (freeMask && getActiveCount() < voiceLimit) {
+            v = lowestVoice(freeMask);
+            stolen = false;
+        } else {
+            // Only when no voice may be added: bounded scan of the sounding voices' ages
+            v = lowestVoice(activeMask);
+            for (uint32_t m = activeMask & (activeMask - 1); m; m &= m - 1) {
+                const size_t i = lowestVoice(m);
+                if (voiceAge[i] < voiceAge[v]) v = i;
+            }
+            stolen = true;
+        }
+
+        assign(v, midiNote);
+        return v;
+    }
+
+    // Give voice v to midiNote whatever it was doing (monophonic mode, stealing)
+    void assign(size_t v, uint8_t midiNote) {
+        midiNote &= 0x7F;
+        releaseVoice(v);
+        const uint32_t bit = 1u << v;
+        activeMask |= bit;
+        heldMask |= bit;
+        voiceNote[v] = midiNote;
+        noteVoices[midiNote] |= bit;
+        voiceAge[v] = ageCounter++;
+    }
+
+    // Key up: mask of the held voices that played midiNote (0 if none)
+    uint32_t release(uint8_t midiNote) {
+        const uint32_t mask = noteVoices[midiNote & 0x7F];
+        noteVoices[midiNote & 0x7F] = 0;
+        heldMask &= ~mask;
+        return mask;
+    }
+
+    // Key up on voice v whatever note it holds (no-op if not held)
+    void releaseVoice(size_t v) {
+        const uint32_t bit = 1u << v;
+        if (!(heldMask & bit)) return;
+        heldMask &= ~bit;
+        noteVoices[voiceNote[v]] &= ~bit;
+    }
+
+    // All envelopes of voice v have finished
+    void retire(size_t v) {
+        releaseVoice(v);
+        activeMask &= ~(1u << v);
+    }
+
+    uint32_t getActiveMask() const { return activeMask; }
+    uint32_t getHeldMask() const { return heldMask; }
+    bool isActive(size_t v) const { return (activeMask >> v) & 1u; }
+
+    // Number of sounding voices
+    size_t getActiveCount() const { return static_cast<size_t>(__builtin_popcount(activeMask)); }
+
+    // Number of keys currently down
+    int getHeldCount() const { return __builtin_popcount(heldMask); }
+
+    // Lanes the renderer must cover: up to the highest active voice
+    size_t getLaneCount() const {
+        return activeMask ? static_cast<size_t>(32 - __builtin_clz(activeMask)) : 0;
+    }
+
+    // Lowest voice of a non-empty mask; walk a mask with for (m = mask; m; m &= m - 1)
+    static inline size_t lowestVoice(uint32_t mask) {
+        return static_cast<size_t>(__builtin_ctz(mask));
+    }
+};
+
+#endif // VOICE_ALLOCATOR_H
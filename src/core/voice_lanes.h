@@ -0,0 +1,63 @@
+#ifndef VOICE_LANES_H
+#define VOICE_LANES_H
+
+#include "constants.h"
+
+// Structure-of-arrays render state shared by all voices
+// Every per-voice field is stored as field[voice] so one step of the render loop
+// (phase advance, waveform lookup, gain ramp) runs for all voices at once and
+// vectorizes across voices (8 floats = one AVX register on PC)
+// Voice, Operator and Oscillator are views over one lane (voice index) of this storage
+constexpr size_t LANE_ALIGNMENT = 32;
+
+#ifdef FIXED_POINT_ENGINE
+// Integer engine (msfa FmOpKernel style): uint32 phase, Q24 samples/gains/pitch multipliers
+typedef uint32_t LanePhase;
+typedef int32_t LaneSample;
+typedef int32_t LanePitch;
+
+constexpr LaneSample LANE_ONE = static_cast<LaneSample>(Q24_ONE);
+
+inline float laneSampleToFloat(LaneSample sample) { return static_cast<float>(sample) * INV_Q24_ONE; }
+inline LanePitch lanePitch(float multiplier) { return static_cast<LanePitch>(multiplier * Q24_ONE_F); }
+#else
+typedef float LanePhase;
+typedef float LaneSample;
+typedef float LanePitch;
+
+constexpr LaneSample LANE_ONE = 1.0f;
+
+inline float laneSampleToFloat(LaneSample sample) { return sample; }
+inline LanePitch lanePitch(float multiplier) { return multiplier; }
+#endif
+
+// One sample of a lane block buffer: one value per voice
+typedef LaneSample LaneRow[POLYPHONY];
+typedef LanePitch PitchRow[POLYPHONY];
+
+// Hot per-operator state, one lane per voice
+struct alignas(LANE_ALIGNMENT) OperatorLanes {
+    LanePhase phase[POLYPHONY] = {0};            // Oscillator phase, one cycle = [0, 1) or 2^32
+    LanePhase phaseInc[POLYPHONY] = {0};         // Oscillator phase increment per sample
+    LaneSample gain[POLYPHONY] = {0};            // Envelope * velocity * level scaling, ramped per sample
+    LaneSample gainStep[POLYPHONY] = {0};        // Per-sample gain increment over the current block
+    LaneSample previousOutput[POLYPHONY] = {0};  // Feedback history
+};
+
+// Lane storage for the whole voice pool plus the block buffers of the lane renderer
+// Block buffers are [sample][voice]
+struct alignas(LANE_ALIGNMENT) VoiceLanes {
+    OperatorLanes operators[NUM_OPERATORS];
+    PitchRow pitchMod[MAX_BLOCK_SIZE] = {{0}};                      // Pitch multiplier (pitch envelope * LFO)
+    LaneRow phaseMod[MAX_BLOCK_SIZE] = {{0}};                       // Summed modulators of current operator
+    LaneRow operatorOutput[NUM_OPERATORS][MAX_BLOCK_SIZE] = {{{0}}};  // Scaled output of each operator
+    LaneRow output[MAX_BLOCK_SIZE] = {{0}};                         // Voice outputs
+    LaneSample panLeft[POLYPHONY];   // Stereo mixdown gains of each voice output
+    LaneSample panRight[POLYPHONY];
+
+    VoiceLanes() {
+        for (size_t v = 0; v < POLYPHONY; ++v) panLeft[v] = panRight[v] = LANE_ONE;  // Centre
+    }
+};
+
+#endif // VOICE_LANES_H
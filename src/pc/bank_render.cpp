@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/config.h"
+#include "core/constants.h"
+#include "core/lut.h"
+#include "core/synth.h"
+#include "core/sysex.h"
+
+#include "pc/thread_pool.h"
+#include "pc/wav_writer.h"
+
+// Bank sweep: renders every preset of every .syx bank with the same test phrase,
+// one WAV file per preset (<output>/<bank>/<NN>_<name>.wav), on all cores
+// Usage: bank_render [presets dir] [output dir] [threads]
+//
+// Banks are decoded up front; the LUTs are built once and only read by the workers.
+// Each job builds its own Synth from the shared, read-only SynthConfig, so a preset
+// renders the same whichever worker picks it up
+
+namespace fs = std::filesystem;
+
+constexpr char DEFAULT_PRESETS_DIR[] = "./presets";
+constexpr char DEFAULT_OUTPUT_DIR[] = "./renders";
+constexpr WavWriter::Format FILE_FORMAT = WavWriter::PCM16;
+constexpr size_t BLOCK_SIZE = 128;         // Same as Teensy AUDIO_BLOCK_SAMPLES
+constexpr uint32_t PHRASE_MS = 3000;       // Test phrase length
+constexpr uint32_t MAX_TAIL_MS = 2000;     // Release tail after the phrase (at most)
+
+// Sample index of a time in milliseconds, in integer: every build places an event
+// on the same sample
+constexpr uint32_t msToSamples(uint32_t ms) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(ms) * static_cast<uint32_t>(SAMPLE_RATE) / 1000);
+}
+
+// Test phrase: a staggered C major chord, then a single high note (velocity 0 = note off)
+struct NoteEvent {
+    uint32_t time;  // Sample index
+    uint8_t note;
+    uint8_t velocity;
+};
+
+const NoteEvent TEST_PHRASE[] = {
+    {msToSamples(0), 48, 100}, {msToSamples(100), 60, 90}, {msToSamples(200), 64, 80}, {msToSamples(300), 67, 70},
+    {msToSamples(2000), 48, 0}, {msToSamples(2000), 60, 0}, {msToSamples(2000), 64, 0}, {msToSamples(2000), 67, 0},
+    {msToSamples(2250), 72, 110},
+    {msToSamples(PHRASE_MS), 72, 0}
+};
+constexpr size_t PHRASE_EVENTS = sizeof(TEST_PHRASE) / sizeof(TEST_PHRASE[0]);
+
+struct PresetJob {
+    SynthConfig config;
+    std::string bankName;
+    std::string presetName;
+    uint8_t index;
+};
+
+// Preset names are free text: keep letters, digits and '-', squeeze the rest to '_'
+static std::string fileSafe(const std::string& name) {
+    std::string safe;
+    for (char c : name) {
+        const bool keep = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-';
+        if (keep) safe += c;
+        else if (!safe.empty() && safe.back() != '_') safe += '_';
+    }
+    while (!safe.empty() && safe.back() == '_') safe.pop_back();
+    return safe.empty() ? "unnamed" : safe;
+}
+
+// Render one preset to its file; returns the number of frames written (0 on error)
+static uint64_t renderPreset(const PresetJob& job, const fs::path& outputDir) {
+    std::unique_ptr<Synth> synth(new Synth());
+    synth->configure(&job.config);
+
+    const std::string number = ((job.index < 10) ? "0" : "") + std::to_string(job.index);
+    const fs::path path = outputDir / fileSafe(job.bankName) / (number + "_" + fileSafe(job.presetName) + ".wav");
+
+    WavWriter writer;
+    if (!writer.open(path.string(), static_cast<uint32_t>(SAMPLE_RATE), 1, FILE_FORMAT)) {
+        std::cerr << "ERROR: Failed to create " << path.string() << "\n";
+        return 0;
+    }
+
+    const size_t phraseSamples = msToSamples(PHRASE_MS);
+    const size_t maxSamples = phraseSamples + msToSamples(MAX_TAIL_MS);
+    float block[BLOCK_SIZE];
+    size_t nextEvent = 0;
+    for (size_t i = 0; i < maxSamples; i += BLOCK_SIZE) {
+        while (nextEvent < PHRASE_EVENTS && TEST_PHRASE[nextEvent].time < i + BLOCK_SIZE) {
+            const NoteEvent& event = TEST_PHRASE[nextEvent++];
+            synth->postEvent(SynthEvent(event.time, SynthEvent::NoteOn, event.note, event.velocity));
+        }
+        // Stop at the end of the phrase once the release tail has died out
+        if (i >= phraseSamples && synth->isIdle()) break;
+
+        const size_t count = (maxSamples - i < BLOCK_SIZE) ? maxSamples - i : BLOCK_SIZE;
+        synth->processBlock(block, count);
+        writer.write(block, count);
+    }
+
+    const uint64_t frames = writer.getFrameCount();
+    return writer.close() ? frames : 0;
+}
+
+int main(int argc, char** argv) {
+    const fs::path presetsDir = (argc > 1) ? argv[1] : DEFAULT_PRESETS_DIR;
+    const fs::path outputDir = (argc > 2) ? argv[2] : DEFAULT_OUTPUT_DIR;
+    const size_t threads = (argc > 3) ? static_cast<size_t>(std::max(0, std::atoi(argv[3]))) : 0;
+
+    // Shared, read-only from here on
+    LUT::init();
+
+    // -------------------------------------------------------------------------
+    // Decode every bank
+    // -------------------------------------------------------------------------
+    std::vector<fs::path> banks;
+    std::error_code error;
+    for (fs::directory_iterator it(presetsDir, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file() && it->path().extension() == ".syx") banks.push_back(it->path());
+    }
+    if (error || banks.empty()) {
+        std::cerr << "ERROR: No .syx bank in " << presetsDir.string() << "\n";
+        return 1;
+    }
+    std::sort(banks.begin(), banks.end());
+
+    std::vector<PresetJob> jobs;
+    SysexHandler sysex;
+    for (const fs::path& bank : banks) {
+        if (!sysex.loadBank(bank.string())) {
+            std::cerr << "WARNING: Skipping unreadable bank " << bank.string() << "\n";
+            continue;
+        }
+        const std::string bankName = bank.stem().string();
+        fs::create_directories(outputDir / fileSafe(bankName), error);
+        if (error) {
+            std::cerr << "ERROR: Cannot create " << (outputDir / fileSafe(bankName)).string() << "\n";
+            return 1;
+        }
+        for (uint8_t p = 0; p < 32; ++p) {
+            PresetJob job;
+            if (!sysex.loadPreset(&job.config, p)) continue;
+            job.bankName = bankName;
+            job.presetName = sysex.getPresetName(p);
+            job.index = p;
+            jobs.push_back(job);
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Render on all cores
+    // -------------------------------------------------------------------------
+    WorkStealingPool pool(threads);
+    std::vector<uint64_t> workerFrames(pool.getWorkerCount(), 0);
+    std::vector<size_t> workerJobs(pool.getWorkerCount(), 0);
+    std::atomic<size_t> failures{0};
+
+    const auto startTime = std::chrono::steady_clock::now();
+    pool.run(jobs.size(), [&](size_t index, size_t worker) {
+        const uint64_t frames = renderPreset(jobs[index], outputDir);
+        if (frames == 0) failures.fetch_add(1, std::memory_order_relaxed);
+        workerFrames[worker] += frames;
+        ++workerJobs[worker];
+    });
+    const auto endTime = std::chrono::steady_clock::now();
+
+    // -------------------------------------------------------------------------
+    // Statistics
+    // -------------------------------------------------------------------------
+    uint64_t totalFrames = 0;
+    for (uint64_t frames : workerFrames) totalFrames += frames;
+    const float wallSeconds = std::chrono::duration<float>(endTime - startTime).count();
+    const float audioSeconds = static_cast<float>(totalFrames) * INV_SAMPLE_RATE;
+
+    std::cout << "=== AS7 Bank Render ===\n";
+    std::cout << "Banks: " << banks.size() << ", presets: " << jobs.size()
+              << ", failed: " << failures.load() << "\n";
+    std::cout << "Output: " << outputDir.string() << "\n";
+    std::cout << "Workers: " << pool.getWorkerCount() << " (jobs stolen: " << pool.getStolenJobs() << ")\n";
+    for (size_t w = 0; w < pool.getWorkerCount(); ++w) {
+        std::cout << "  worker " << w << ": " << workerJobs[w] << " presets\n";
+    }
+    std::cout << "Audio rendered: " << audioSeconds << " seconds\n";
+    std::cout << "Wall time: " << wallSeconds << " seconds\n";
+    std::cout << "Real-time factor: " << (audioSeconds / wallSeconds) << "x\n";
+
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+    #include <sched.h>
+#endif
+
+#include "core/config.h"
+#include "core/connections.h"
+#include "core/constants.h"
+#include "core/envelope.h"
+#include "core/lfo.h"
+#include "core/lut.h"
+#include "core/oscillator.h"
+#include "core/pitchenv.h"
+#include "core/synth.h"
+
+// Benchmark suite: DSP building blocks (micro) and the full synth (macro)
+// Usage: benchmark [all|micro|macro] [cpu]
+//
+// Every case is run WARMUP_RUNS times untimed, then TIMED_RUNS times; the median run
+// is reported, in nanoseconds per sample. Per-run setup (state reset, note-on) is
+// outside the timed region. The process is pinned to one CPU (Linux, default 0) so
+// runs are not migrated between cores. Build with the same flags as fm_synth
+// (compile_PC.sh benchmark) for numbers comparable with the renderer
+
+constexpr size_t WARMUP_RUNS = 3;
+constexpr size_t TIMED_RUNS = 15;
+constexpr size_t MICRO_SAMPLES = 4096;     // Samples per micro run
+constexpr size_t MACRO_BLOCKS = 32;        // Blocks per synth run
+constexpr size_t BLOCK_SIZE = 128;         // Same as Teensy AUDIO_BLOCK_SAMPLES
+constexpr size_t NUM_ALGORITHMS = 32;
+constexpr uint8_t POLYPHONY_STEPS[] = {1, 4, 8, 16};
+constexpr uint8_t FEEDBACK_STEPS[] = {0, 7};
+constexpr double SAMPLE_BUDGET_NS = 1e9 / SAMPLE_RATE;  // Real-time budget of one sample
+
+// Results are accumulated here so the measured work cannot be optimised away
+volatile float sink = 0.0f;
+
+// Median ns per sample of body(), which processes samples samples per call
+template<typename Setup, typename Body>
+static double measure(size_t samples, Setup setup, Body body) {
+    for (size_t run = 0; run < WARMUP_RUNS; ++run) {
+        setup();
+        body();
+    }
+
+    std::vector<double> times;
+    times.reserve(TIMED_RUNS);
+    for (size_t run = 0; run < TIMED_RUNS; ++run) {
+        setup();
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        const auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(samples));
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+static void report(const std::string& name, double nsPerSample) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << nsPerSample << " ns/sample\n";
+}
+
+static bool pinToCpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// ============================================================================
+// Micro benchmarks
+// ============================================================================
+
+static void benchOscillator() {
+    static const char* const NAMES[] = {"sine", "triangle", "saw down", "saw up", "square"};
+    std::cout << "Oscillator::process\n";
+    for (uint8_t waveform = 0; waveform < 5; ++waveform) {
+        LanePhase phase{};
+        LanePhase increment{};
+        Oscillator oscillator(&phase, &increment);
+        oscillator.setFrequency(440.0f);
+        const double ns = measure(MICRO_SAMPLES, [&] { oscillator.reset(); }, [&] {
+            float sum = 0.0f;
+            float modulation = 0.0f;
+            for (size_t i = 0; i < MICRO_SAMPLES; ++i) {
+                modulation = oscillator.process(modulation * 0.5f, 1.0f, waveform);
+                sum += modulation;
+            }
+            sink = sum;
+        });
+        report(NAMES[waveform], ns);
+    }
+}
+
+static void benchEnvelope() {
+    // Slow rates keep each state running for the whole measured run
+    struct EnvelopeCase {
+        const char* name;
+        EnvelopeConfig config;
+        uint8_t state;  // Advance to this state before timing
+        bool release;
+    };
+    const EnvelopeCase CASES[] = {
+        {"attack",  EnvelopeConfig(99, 99, 50, 80, 0, 20, 99, 99, 99), 0, false},
+        {"decay",   EnvelopeConfig(99, 99, 20, 80, 0, 99, 10, 99, 99), 1, false},
+        {"sustain", EnvelopeConfig(99, 99, 99, 80, 0, 99, 99, 99, 99), 3, false},
+        {"release", EnvelopeConfig(99, 99, 99, 80, 0, 99, 99, 99, 5),  3, true},
+        {"idle",    EnvelopeConfig(99, 99, 99, 80, 0, 99, 99, 99, 99), 4, false},
+    };
+
+    std::cout << "Envelope::process\n";
+    for (const EnvelopeCase& test : CASES) {
+        Envelope envelope;
+        envelope.setConfig(&test.config);
+        auto setup = [&] {
+            envelope.setConfig(&test.config);
+            if (test.state >= 4) return;
+            envelope.trigger(0);
+            while (envelope.getState() < test.state) envelope.process();
+            if (test.release) envelope.release();
+        };
+        const double ns = measure(MICRO_SAMPLES, setup, [&] {
+            float sum = 0.0f;
+            for (size_t i = 0; i < MICRO_SAMPLES; ++i) sum += envelope.process();
+            sink = sum;
+        });
+        report(test.name, ns);
+    }
+}
+
+static void benchLUT() {
+    std::vector<float> phases(MICRO_SAMPLES);
+    std::vector<float> exponents(MICRO_SAMPLES);
+    for (size_t i = 0; i < MICRO_SAMPLES; ++i) {
+        phases[i] = static_cast<float>(i) / static_cast<float>(MICRO_SAMPLES);
+        exponents[i] = -14.0f + 20.0f * static_cast<float>(i) / static_cast<float>(MICRO_SAMPLES);
+    }
+
+    std::cout << "LUT\n";
+    report("sin", measure(MICRO_SAMPLES, [] {}, [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < MICRO_SAMPLES; ++i) sum += LUT::sin(phases[i]);
+        sink = sum;
+    }));
+    report("exp2", measure(MICRO_SAMPLES, [] {}, [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < MICRO_SAMPLES; ++i) sum += LUT::exp2(exponents[i]);
+        sink = sum;
+    }));
+}
+
+static void benchLFO() {
+    static const char* const NAMES[] = {"triangle", "saw down", "saw up", "square", "sine", "sample & hold"};
+    std::cout << "LFO::process\n";
+    for (uint8_t waveform = 0; waveform < 6; ++waveform) {
+        const LFOConfig config(waveform, 60, 0, 50, 50, 3, false);
+        LFO lfo;
+        lfo.configure(&config);
+        const double ns = measure(MICRO_SAMPLES, [&] { lfo.trigger(); }, [&] {
+            float sum = 0.0f;
+            for (size_t i = 0; i < MICRO_SAMPLES; ++i) {
+                lfo.process();
+                sum += static_cast<float>(lfo.getPitchMod() + lfo.getAmpMod());
+            }
+            sink = sum;
+        });
+        report(NAMES[waveform], ns);
+    }
+}
+
+static void benchPitchEnvelope() {
+    std::cout << "PitchEnvelope::process\n";
+    const PitchEnvelopeConfig config(99, 0, 70, 0, 20, 20, 20, 20);  // Slow sweeps
+    PitchEnvelope envelope;
+    envelope.setConfig(&config);
+
+    report("attack", measure(MICRO_SAMPLES, [&] { envelope.trigger(); }, [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < MICRO_SAMPLES; ++i) sum += envelope.process();
+        sink = sum;
+    }));
+
+    report("release", measure(MICRO_SAMPLES, [&] { envelope.trigger(); envelope.release(); }, [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < MICRO_SAMPLES; ++i) sum += envelope.process();
+        sink = sum;
+    }));
+}
+
+// ============================================================================
+// Macro benchmark: Synth::processBlock, algorithm x polyphony x feedback
+// ============================================================================
+
+// Six sounding operators at full sustain, spread ratios, chosen algorithm and feedback
+static SynthConfig makeConfig(size_t algorithm, uint8_t feedback) {
+    OperatorConfig operators[NUM_OPERATORS];
+    for (size_t op = 0; op < NUM_OPERATORS; ++op) {
+        operators[op] = OperatorConfig(
+            true,
+            FrequencyConfig(false, 7, static_cast<uint8_t>(1 + op % 3), 0),
+            EnvelopeConfig(90, 99, 99, 99, 0, 99, 99, 99, 60),
+            0,
+            0
+        );
+    }
+    return SynthConfig(VoiceConfig(operators, Algorithms::ALL_ALGORITHMS[algorithm], feedback, 24));
+}
+
+// ns per output sample of one block render with polyphony held notes
+static double measureSynth(const SynthConfig& config, uint8_t polyphony, bool& voicesOk) {
+    std::unique_ptr<Synth> synth(new Synth());
+    synth->configure(&config);
+    synth->setVoiceLimit(POLYPHONY);
+
+    float buffer[BLOCK_SIZE];
+    for (uint8_t v = 0; v < polyphony; ++v) {
+        synth->postEvent(SynthEvent(synth->getSampleTime(), SynthEvent::NoteOn,
+                                    static_cast<uint8_t>(36 + 3 * v), 100));
+    }
+    synth->processBlock(buffer, BLOCK_SIZE);  // Notes start, attack done
+    voicesOk = synth->getActiveVoiceCount() == polyphony;
+
+    return measure(MACRO_BLOCKS * BLOCK_SIZE, [] {}, [&] {
+        float sum = 0.0f;
+        for (size_t block = 0; block < MACRO_BLOCKS; ++block) {
+            synth->processBlock(buffer, BLOCK_SIZE);
+            sum += buffer[0];
+        }
+        sink = sum;
+    });
+}
+
+static void benchSynth() {
+    std::cout << "Synth::processBlock (" << BLOCK_SIZE << "-sample blocks), ns per output sample\n";
+    std::cout << "  alg  fb";
+    for (uint8_t polyphony : POLYPHONY_STEPS) std::cout << std::setw(9) << ("poly " + std::to_string(polyphony));
+    std::cout << std::setw(14) << "ns/voice" << std::setw(14) << "voices/core" << "\n";
+
+    double worstVoices = 1e30;
+    bool allVoicesOk = true;
+    for (size_t algorithm = 0; algorithm < NUM_ALGORITHMS; ++algorithm) {
+        for (uint8_t feedback : FEEDBACK_STEPS) {
+            const SynthConfig config = makeConfig(algorithm, feedback);
+            std::cout << "  " << std::setw(3) << (algorithm + 1) << std::setw(4) << static_cast<int>(feedback);
+
+            double nsPerVoice = 0.0;
+            for (uint8_t polyphony : POLYPHONY_STEPS) {
+                bool voicesOk = false;
+                const double ns = measureSynth(config, polyphony, voicesOk);
+                allVoicesOk = allVoicesOk && voicesOk;
+                std::cout << std::fixed << std::setprecision(1) << std::setw(9) << ns;
+                nsPerVoice = ns / polyphony;  // Largest polyphony: fixed costs amortised
+            }
+
+            // Voices one core sustains in real time at 44.1 kHz
+            const double voicesPerCore = SAMPLE_BUDGET_NS / nsPerVoice;
+            worstVoices = std::min(worstVoices, voicesPerCore);
+            std::cout << std::setprecision(2) << std::setw(14) << nsPerVoice
+                      << std::setprecision(0) << std::setw(14) << voicesPerCore << "\n";
+        }
+    }
+    std::cout << "  Worst case: " << std::setprecision(0) << worstVoices << " voices per core at "
+              << SAMPLE_RATE << " Hz\n";
+    if (!allVoicesOk) std::cout << "  WARNING: some runs did not hold the requested polyphony\n";
+}
+
+int main(int argc, char** argv) {
+    const std::string mode = (argc > 1) ? argv[1] : "all";
+    const int cpu = (argc > 2) ? std::atoi(argv[2]) : 0;
+    if (mode != "all" && mode != "micro" && mode != "macro") {
+        std::cerr << "Usage: benchmark [all|micro|macro] [cpu]\n";
+        return 1;
+    }
+
+    LUT::init();
+
+    // The macro table times the specialised kernels: they must route like the configs
+    const int mismatch = AlgorithmKernels::findTopologyMismatch();
+    if (mismatch >= 0) {
+        std::cerr << "ERROR: ALGORITHM_TOPOLOGY does not match the config of algorithm " << (mismatch + 1) << "\n";
+        return 1;
+    }
+
+    std::cout << "=== AS7 Benchmark ===\n";
+    std::cout << "CPU pinning: " << (pinToCpu(cpu) ? "cpu " + std::to_string(cpu) : std::string("unavailable")) << "\n";
+    std::cout << "Runs: " << WARMUP_RUNS << " warm-up, median of " << TIMED_RUNS << "\n";
+#ifdef FIXED_POINT_ENGINE
+    std::cout << "Engine: fixed point (Q24)\n";
+#else
+    std::cout << "Engine: float\n";
+#endif
+
+    if (mode != "macro") {
+        benchOscillator();
+        benchEnvelope();
+        benchLUT();
+        benchLFO();
+        benchPitchEnvelope();
+    }
+    if (mode != "micro") {
+        benchSynth();
+    }
+    return 0;
+}
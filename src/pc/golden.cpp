@@ -0,0 +1,509 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/config.h"
+#include "core/constants.h"
+#include "core/lut.h"
+#include "core/synth.h"
+#include "core/sysex.h"
+
+#include "pc/wav_reader.h"
+#include "pc/wav_writer.h"
+
+// Golden-audio regression check: renders a fixed set of presets and phrases and
+// compares them with reference renders recorded from a known-good build
+// Usage: golden record [dir]
+//        golden check [dir] [--exact | --spectral] [--max-abs X] [--spectral-mean dB] [--spectral-max dB]
+//
+// record writes one float32 stereo WAV per case (<dir>/<case>.wav). check renders the
+// same cases again and compares them three ways:
+//  - sample-exact: number of samples that differ bit for bit
+//  - max-abs: largest sample difference (linear, and in dBFS)
+//  - spectral: log-spectral distance between short-time spectra (dB, mean and worst frame)
+// A case passes when both its max-abs error and its spectral distance are within
+// tolerance; --exact demands identical samples, --spectral gates on the spectrum alone
+// (intended phase or rounding changes that move samples but not the sound). A render
+// with NaN or infinite samples always fails. Failed renders are kept in <dir>/failed/
+// for listening. Exit code 1 on any failure, so a performance change can be gated on
+// "no audible regression"
+//
+// Float and integer engines do not render the same samples: each one has its own
+// reference set (default <dir>: golden/float or golden/fixed)
+
+namespace fs = std::filesystem;
+
+#ifdef FIXED_POINT_ENGINE
+constexpr char DEFAULT_GOLDEN_DIR[] = "./golden/fixed";
+#else
+constexpr char DEFAULT_GOLDEN_DIR[] = "./golden/float";
+#endif
+constexpr size_t BLOCK_SIZE = 128;        // Same as Teensy AUDIO_BLOCK_SAMPLES
+constexpr uint32_t RENDER_MS = 4000;      // Phrase and release tail (every case)
+constexpr uint16_t CHANNELS = 2;
+
+// Default tolerances (overridden on the command line)
+constexpr float DEFAULT_MAX_ABS = 1e-4f;          // About -80 dBFS
+constexpr float DEFAULT_SPECTRAL_MEAN_DB = 0.1f;
+constexpr float DEFAULT_SPECTRAL_MAX_DB = 1.0f;
+
+// Short-time spectrum: Hann window, 50% overlap; bins below the floor (16-bit noise
+// level) are clamped to it so that silence and reverb tails do not dominate
+constexpr size_t FFT_SIZE = 2048;
+constexpr size_t FFT_HOP = FFT_SIZE / 2;
+constexpr float SPECTRAL_FLOOR_DB = -96.0f;
+
+// =============================================================================
+// Test cases
+// =============================================================================
+
+enum class Phrase : uint8_t {
+    Chord,       // Staggered chord, held then released (attack, sustain, release)
+    Arpeggio,    // Fast wide arpeggio past the voice count (stealing, key scaling)
+    Expression   // Held note with pitch bend sweeps and mod wheel (controllers, LFO)
+};
+
+struct GoldenCase {
+    const char* name;
+    const char* bankPath;
+    uint8_t preset;
+    Phrase phrase;
+    bool effects;      // Filter, drive, chorus and reverb after the synth
+    uint8_t unison;    // Voices per note (1 = off)
+};
+
+// ROM1A 7, 9, 11, 12, 13 and HEAVY RAIN are the presets listed as wrong in notes_AS7.txt
+const GoldenCase CASES[] = {
+    {"rom1a_00_brass1",      "./presets/ROM1A_Master.syx",       0,  Phrase::Chord,      false, 1},
+    {"rom1a_07_piano1",      "./presets/ROM1A_Master.syx",       7,  Phrase::Arpeggio,   false, 1},
+    {"rom1a_09_piano3",      "./presets/ROM1A_Master.syx",       9,  Phrase::Arpeggio,   false, 1},
+    {"rom1a_10_epiano1",     "./presets/ROM1A_Master.syx",       10, Phrase::Chord,      false, 1},
+    {"rom1a_11_guitar1",     "./presets/ROM1A_Master.syx",       11, Phrase::Arpeggio,   false, 1},
+    {"rom1a_12_guitar2",     "./presets/ROM1A_Master.syx",       12, Phrase::Chord,      false, 1},
+    {"rom1a_13_synlead1",    "./presets/ROM1A_Master.syx",       13, Phrase::Expression, false, 1},
+    {"rom1a_14_bass1",       "./presets/ROM1A_Master.syx",       14, Phrase::Arpeggio,   false, 1},
+    {"rom1a_25_tubbells",    "./presets/ROM1A_Master.syx",       25, Phrase::Chord,      false, 1},
+    {"vrc105a_00_heavyrain", "./presets/VRC105A_Sound_Effet.syx", 0, Phrase::Chord,      false, 1},
+    {"rom1a_10_epiano1_fx",  "./presets/ROM1A_Master.syx",       10, Phrase::Chord,      true,  3},
+};
+constexpr size_t CASE_COUNT = sizeof(CASES) / sizeof(CASES[0]);
+
+struct PhraseEvent {
+    uint32_t time;  // Sample index
+    SynthEvent::Type type;
+    uint8_t data1;
+    uint16_t data2;
+};
+
+// Sample index of a time in milliseconds, in integer: every build places an event
+// on the same sample
+constexpr uint32_t msToSamples(uint32_t ms) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(ms) * static_cast<uint32_t>(SAMPLE_RATE) / 1000);
+}
+
+static std::vector<PhraseEvent> buildPhrase(Phrase phrase) {
+    std::vector<PhraseEvent> events;
+    switch (phrase) {
+        case Phrase::Chord: {
+            const uint8_t notes[] = {48, 60, 64, 67};
+            for (uint32_t i = 0; i < 4; ++i) {
+                events.push_back({msToSamples(100 * i), SynthEvent::NoteOn, notes[i], static_cast<uint16_t>(100 - 10 * i)});
+                events.push_back({msToSamples(2000), SynthEvent::NoteOff, notes[i], 0});
+            }
+            break;
+        }
+        case Phrase::Arpeggio: {
+            // 24 notes over three octaves, each one held past the next ones
+            const uint8_t steps[] = {0, 4, 7, 11};
+            for (uint8_t i = 0; i < 24; ++i) {
+                const uint8_t note = static_cast<uint8_t>(36 + 12 * (i / 4 % 3) + steps[i % 4]);
+                const uint32_t start = 100u * i;
+                events.push_back({msToSamples(start), SynthEvent::NoteOn, note, static_cast<uint16_t>(40 + (i * 37) % 87)});
+                events.push_back({msToSamples(start + 350), SynthEvent::NoteOff, note, 0});
+            }
+            break;
+        }
+        case Phrase::Expression: {
+            events.push_back({0, SynthEvent::NoteOn, 60, 100});
+            // Bend up a full range, down a full range and back in straight ramps, 20 steps
+            // per second
+            for (int i = 1; i <= 40; ++i) {
+                const int step = (i <= 10) ? i : (i <= 30) ? 20 - i : i - 40;  // -10 to 10
+                events.push_back({msToSamples(250 + 50 * static_cast<uint32_t>(i)), SynthEvent::PitchBend, 0,
+                                  static_cast<uint16_t>(8192 + step * 8191 / 10)});
+            }
+            // Mod wheel up then down over the held note
+            for (int i = 0; i <= 20; ++i) {
+                const uint16_t value = static_cast<uint16_t>((i <= 10 ? i : 20 - i) * 127 / 10);
+                events.push_back({msToSamples(1000 + 100 * static_cast<uint32_t>(i)), SynthEvent::ControlChange, 1, value});
+            }
+            events.push_back({msToSamples(3000), SynthEvent::NoteOff, 60, 0});
+            break;
+        }
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const PhraseEvent& a, const PhraseEvent& b) { return a.time < b.time; });
+    return events;
+}
+
+// Render one case, interleaved stereo; empty if the preset cannot be loaded
+static std::vector<float> renderCase(const GoldenCase& test) {
+    std::vector<float> output;
+    SynthConfig config;
+    SysexHandler sysex;
+    if (!sysex.loadBank(test.bankPath) || !sysex.loadPreset(&config, test.preset)) return output;
+
+    std::unique_ptr<Synth> synth(new Synth());
+    synth->configure(&config);
+    if (test.unison > 1) synth->setUnison(test.unison, 20, 80);
+    if (test.effects) {
+        FxChain& effects = synth->getEffects();
+        effects.setFilter(70, 40);
+        effects.setDrive(20, 99);
+        effects.setChorus(30, 50, 40);
+        effects.setReverb(60, 40, 25);
+        effects.setEnabled(FxChain::FILTER, true);
+        effects.setEnabled(FxChain::DRIVE, true);
+        effects.setEnabled(FxChain::CHORUS, true);
+        effects.setEnabled(FxChain::REVERB, true);
+    }
+
+    const std::vector<PhraseEvent> events = buildPhrase(test.phrase);
+    const size_t totalSamples = msToSamples(RENDER_MS);
+    output.resize(totalSamples * CHANNELS);
+
+    float left[BLOCK_SIZE];
+    float right[BLOCK_SIZE];
+    size_t nextEvent = 0;
+    for (size_t i = 0; i < totalSamples; i += BLOCK_SIZE) {
+        // Events go through the synth's queue one block ahead, like the other renderers
+        while (nextEvent < events.size() && events[nextEvent].time < i + BLOCK_SIZE) {
+            const PhraseEvent& event = events[nextEvent++];
+            synth->postEvent(SynthEvent(event.time, event.type, event.data1, event.data2));
+        }
+        const size_t count = std::min(BLOCK_SIZE, totalSamples - i);
+        synth->processBlock(left, right, count);
+        for (size_t j = 0; j < count; ++j) {
+            output[(i + j) * 2] = left[j];
+            output[(i + j) * 2 + 1] = right[j];
+        }
+    }
+    return output;
+}
+
+// =============================================================================
+// Metrics
+// =============================================================================
+
+// In-place radix-2 FFT (size is a power of two)
+static void fft(std::vector<std::complex<double>>& data) {
+    const size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (size_t length = 2; length <= n; length <<= 1) {
+        const double angle = -2.0 * M_PI / static_cast<double>(length);
+        const std::complex<double> step(std::cos(angle), std::sin(angle));
+        for (size_t start = 0; start < n; start += length) {
+            std::complex<double> twiddle(1.0, 0.0);
+            for (size_t k = 0; k < length / 2; ++k) {
+                const std::complex<double> even = data[start + k];
+                const std::complex<double> odd = data[start + k + length / 2] * twiddle;
+                data[start + k] = even + odd;
+                data[start + k + length / 2] = even - odd;
+                twiddle *= step;
+            }
+        }
+    }
+}
+
+// Level spectrum (dBFS, floored) of one windowed frame of one channel
+static void frameSpectrum(const std::vector<float>& samples, size_t channel, size_t start,
+                          const std::vector<double>& window, std::vector<float>& spectrum) {
+    std::vector<std::complex<double>> data(FFT_SIZE);
+    for (size_t i = 0; i < FFT_SIZE; ++i) {
+        const size_t index = (start + i) * CHANNELS + channel;
+        const double sample = (index < samples.size()) ? samples[index] : 0.0;
+        data[i] = std::complex<double>(sample * window[i], 0.0);
+    }
+    fft(data);
+
+    // A full-scale sine peaks at 0 dB (Hann window: coherent gain 1/2)
+    const double scale = 4.0 / static_cast<double>(FFT_SIZE);
+    spectrum.resize(FFT_SIZE / 2 + 1);
+    for (size_t k = 0; k <= FFT_SIZE / 2; ++k) {
+        const double magnitude = std::abs(data[k]) * scale;
+        const float level = (magnitude > 0.0) ? static_cast<float>(20.0 * std::log10(magnitude)) : SPECTRAL_FLOOR_DB;
+        spectrum[k] = std::max(level, SPECTRAL_FLOOR_DB);
+    }
+}
+
+// Golden is built with -ffast-math, which lets the compiler assume no NaN or infinity
+// (std::isnan folds to false): test the exponent bits instead
+static bool isFiniteSample(float sample) {
+    uint32_t bits;
+    std::memcpy(&bits, &sample, sizeof(bits));
+    return (bits & 0x7F800000u) != 0x7F800000u;
+}
+
+struct Comparison {
+    bool sameLength = true;
+    size_t nonFiniteSamples = 0;  // NaN or infinite samples in the render
+    size_t differingSamples = 0;
+    float maxAbsError = 0.0f;
+    float maxAbsTime = 0.0f;      // Seconds, first sample with the largest error
+    float spectralMeanDb = 0.0f;  // Mean over non-silent frames of the RMS log-spectral distance
+    float spectralMaxDb = 0.0f;   // Worst frame
+    float spectralMaxTime = 0.0f;
+};
+
+static Comparison compare(const std::vector<float>& reference, const std::vector<float>& render) {
+    Comparison result;
+    result.sameLength = (reference.size() == render.size());
+    const size_t count = std::min(reference.size(), render.size());
+    result.differingSamples = std::max(reference.size(), render.size()) - count;
+
+    for (size_t i = 0; i < render.size(); ++i) {
+        if (!isFiniteSample(render[i])) ++result.nonFiniteSamples;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (std::memcmp(&reference[i], &render[i], sizeof(float)) != 0) ++result.differingSamples;
+        if (!isFiniteSample(reference[i]) || !isFiniteSample(render[i])) continue;
+        const float error = std::fabs(reference[i] - render[i]);
+        if (error > result.maxAbsError) {
+            result.maxAbsError = error;
+            result.maxAbsTime = static_cast<float>(i / CHANNELS) * INV_SAMPLE_RATE;
+        }
+    }
+    // Spectra of non-finite samples mean nothing: such a case fails whatever they say
+    if (result.differingSamples == 0 || result.nonFiniteSamples > 0) return result;
+
+    std::vector<double> window(FFT_SIZE);
+    for (size_t i = 0; i < FFT_SIZE; ++i) {
+        window[i] = 0.5 - 0.5 * std::cos(2.0 * M_PI * static_cast<double>(i) / static_cast<double>(FFT_SIZE));
+    }
+
+    const size_t frames = std::max(reference.size(), render.size()) / CHANNELS;
+    std::vector<float> referenceSpectrum;
+    std::vector<float> renderSpectrum;
+    double distanceSum = 0.0;
+    size_t frameCount = 0;
+    for (size_t start = 0; start < frames; start += FFT_HOP) {
+        double squareSum = 0.0;
+        bool silent = true;
+        for (size_t channel = 0; channel < CHANNELS; ++channel) {
+            frameSpectrum(reference, channel, start, window, referenceSpectrum);
+            frameSpectrum(render, channel, start, window, renderSpectrum);
+            for (size_t k = 0; k < referenceSpectrum.size(); ++k) {
+                const double difference = static_cast<double>(referenceSpectrum[k] - renderSpectrum[k]);
+                squareSum += difference * difference;
+                silent = silent && referenceSpectrum[k] <= SPECTRAL_FLOOR_DB && renderSpectrum[k] <= SPECTRAL_FLOOR_DB;
+            }
+        }
+        // Frames below the floor in both renders would only dilute the mean
+        if (silent) continue;
+        const float distance = static_cast<float>(std::sqrt(squareSum / static_cast<double>(CHANNELS * (FFT_SIZE / 2 + 1))));
+        if (distance > result.spectralMaxDb) {
+            result.spectralMaxDb = distance;
+            result.spectralMaxTime = static_cast<float>(start) * INV_SAMPLE_RATE;
+        }
+        distanceSum += distance;
+        ++frameCount;
+    }
+    if (frameCount > 0) result.spectralMeanDb = static_cast<float>(distanceSum / static_cast<double>(frameCount));
+    return result;
+}
+
+// =============================================================================
+// Modes
+// =============================================================================
+
+struct Tolerances {
+    bool exact = false;
+    bool spectralOnly = false;  // Max-abs reported, not gated
+    float maxAbs = DEFAULT_MAX_ABS;
+    float spectralMeanDb = DEFAULT_SPECTRAL_MEAN_DB;
+    float spectralMaxDb = DEFAULT_SPECTRAL_MAX_DB;
+};
+
+static bool passes(const Comparison& result, const Tolerances& tolerances) {
+    if (!result.sameLength || result.nonFiniteSamples > 0) return false;
+    if (tolerances.exact) return result.differingSamples == 0;
+    const bool spectralOk = result.spectralMeanDb <= tolerances.spectralMeanDb &&
+                            result.spectralMaxDb <= tolerances.spectralMaxDb;
+    return spectralOk && (tolerances.spectralOnly || result.maxAbsError <= tolerances.maxAbs);
+}
+
+static float toDb(float linear) {
+    return (linear > 1e-10f) ? 20.0f * std::log10(linear) : -200.0f;  // Identical: -200 dB
+}
+
+// Interleaved stereo render to a float32 WAV file
+static bool saveRender(const fs::path& path, const std::vector<float>& render) {
+    WavWriter writer;
+    if (!writer.open(path.string(), static_cast<uint32_t>(SAMPLE_RATE), CHANNELS, WavWriter::FLOAT32)) return false;
+    const bool written = writer.write(render.data(), render.size() / CHANNELS);
+    return writer.close() && written;
+}
+
+static int record(const fs::path& goldenDir) {
+    std::error_code error;
+    fs::create_directories(goldenDir, error);
+    if (error) {
+        std::cerr << "ERROR: Cannot create " << goldenDir.string() << "\n";
+        return 1;
+    }
+
+    size_t failures = 0;
+    for (const GoldenCase& test : CASES) {
+        const std::vector<float> render = renderCase(test);
+        const fs::path path = goldenDir / (std::string(test.name) + ".wav");
+        if (render.empty()) {
+            std::cerr << "ERROR: Cannot load preset " << static_cast<int>(test.preset) << " of " << test.bankPath << "\n";
+            ++failures;
+            continue;
+        }
+        if (std::find_if_not(render.begin(), render.end(), isFiniteSample) != render.end()) {
+            std::cerr << "ERROR: " << test.name << " renders NaN or infinite samples, not recorded\n";
+            ++failures;
+            continue;
+        }
+        if (!saveRender(path, render)) {
+            std::cerr << "ERROR: Failed to write " << path.string() << "\n";
+            ++failures;
+            continue;
+        }
+        std::cout << "  recorded " << path.string() << "\n";
+    }
+
+    std::cout << "Recorded " << (CASE_COUNT - failures) << "/" << CASE_COUNT << " references in "
+              << goldenDir.string() << "\n";
+    return failures == 0 ? 0 : 1;
+}
+
+static int check(const fs::path& goldenDir, const Tolerances& tolerances) {
+    const fs::path failedDir = goldenDir / "failed";
+    size_t failures = 0;
+    size_t saved = 0;  // Failed renders written to failedDir
+
+    std::cout << "=== AS7 Golden Check ===\n";
+    std::cout << "References: " << goldenDir.string() << "\n";
+    if (tolerances.exact) {
+        std::cout << "Tolerance: sample-exact\n";
+    } else {
+        std::cout << "Tolerance: ";
+        if (!tolerances.spectralOnly) {
+            std::cout << "max-abs " << tolerances.maxAbs << " (" << toDb(tolerances.maxAbs) << " dBFS), ";
+        }
+        std::cout << "spectral mean " << tolerances.spectralMeanDb << " dB and max "
+                  << tolerances.spectralMaxDb << " dB\n";
+    }
+    std::cout << std::left << std::setw(24) << "case" << std::right << std::setw(10) << "differ"
+              << std::setw(12) << "max-abs dB" << std::setw(10) << "at (s)" << std::setw(11) << "spec mean"
+              << std::setw(10) << "spec max" << std::setw(10) << "at (s)" << "  result\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (const GoldenCase& test : CASES) {
+        const fs::path path = goldenDir / (std::string(test.name) + ".wav");
+        std::vector<float> reference;
+        uint16_t channels = 0;
+        uint32_t sampleRate = 0;
+        if (!WavReader::read(path.string(), reference, channels, sampleRate) ||
+            channels != CHANNELS || sampleRate != static_cast<uint32_t>(SAMPLE_RATE)) {
+            std::cout << std::left << std::setw(24) << test.name << std::right
+                      << "  missing or unusable reference (run: golden record)  FAIL\n";
+            ++failures;
+            continue;
+        }
+
+        const std::vector<float> render = renderCase(test);
+        if (render.empty()) {
+            std::cout << std::left << std::setw(24) << test.name << std::right << "  cannot load preset  FAIL\n";
+            ++failures;
+            continue;
+        }
+
+        const Comparison result = compare(reference, render);
+        const bool pass = passes(result, tolerances);
+        std::cout << std::left << std::setw(24) << test.name << std::right << std::setw(10) << result.differingSamples
+                  << std::setw(12) << toDb(result.maxAbsError) << std::setw(10) << result.maxAbsTime
+                  << std::setw(11) << result.spectralMeanDb << std::setw(10) << result.spectralMaxDb
+                  << std::setw(10) << result.spectralMaxTime << "  " << (pass ? "ok" : "FAIL")
+                  << (result.sameLength ? "" : " (length)")
+                  << (result.nonFiniteSamples ? " (NaN/inf)" : "") << "\n";
+
+        if (!pass) {
+            ++failures;
+            std::error_code error;
+            fs::create_directories(failedDir, error);
+            if (saveRender(failedDir / (std::string(test.name) + ".wav"), render)) ++saved;
+        }
+    }
+
+    std::cout << (CASE_COUNT - failures) << "/" << CASE_COUNT << " cases passed";
+    if (saved > 0) std::cout << ", failed renders in " << failedDir.string();
+    std::cout << "\n";
+    return failures == 0 ? 0 : 1;
+}
+
+static void usage() {
+    std::cerr << "Usage: golden record [dir]\n"
+              << "       golden check [dir] [--exact | --spectral] [--max-abs X] [--spectral-mean dB] [--spectral-max dB]\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    const std::string mode = argv[1];
+    fs::path goldenDir = DEFAULT_GOLDEN_DIR;
+    Tolerances tolerances;
+
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        if (arg == "--exact") {
+            tolerances.exact = true;
+        } else if (arg == "--spectral") {
+            tolerances.spectralOnly = true;
+        } else if (arg == "--max-abs" && hasValue) {
+            tolerances.maxAbs = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--spectral-mean" && hasValue) {
+            tolerances.spectralMeanDb = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--spectral-max" && hasValue) {
+            tolerances.spectralMaxDb = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg.compare(0, 2, "--") != 0) {
+            goldenDir = arg;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    LUT::init();
+
+    // The specialised kernels must route like the configs the references were made from
+    const int mismatch = AlgorithmKernels::findTopologyMismatch();
+    if (mismatch >= 0) {
+        std::cerr << "ERROR: ALGORITHM_TOPOLOGY does not match the config of algorithm " << (mismatch + 1) << "\n";
+        return 1;
+    }
+
+    if (mode == "record") return record(goldenDir);
+    if (mode == "check") return check(goldenDir, tolerances);
+    usage();
+    return 2;
+}
@@ -1,7 +1,6 @@
 #define DEBUG_PC
 
 #include <iostream>
-#include <vector>
 #include <chrono>
 
 #include "core/config.h"
@@ -14,17 +13,47 @@
 #include "core/sysex.h"
 
 #include "pc/wav_writer.h"
+#include "pc/midi_file.h"
+#include "pc/midi_player.h"
 
 // Test parameters
 constexpr char FILE_NAME[] = "fm_synth.wav";
 constexpr char BANK_FILE_PATH[] = "./presets/ROM1A_Master.syx";
 constexpr uint8_t PRESET_NUMBER = 10; // 0-31
+constexpr bool USE_EFFECTS = false;     // Filter, drive, chorus and reverb after the synth
+constexpr WavWriter::Format FILE_FORMAT = WavWriter::FLOAT32;  // PCM16 / PCM24: dithered integer export
+constexpr uint16_t CHANNELS = 2;        // 1 = mono mix, 2 = stereo (pan, unison, effects)
 
 constexpr float NOTE_DURATION = 8.0f;   
 constexpr float TOTAL_DURATION = 12.0f;
 constexpr size_t TOTAL_SAMPLES = static_cast<size_t>(SAMPLE_RATE * TOTAL_DURATION);
+constexpr size_t BLOCK_SIZE = 128; // Same as Teensy AUDIO_BLOCK_SAMPLES
+constexpr float MIDI_MAX_TAIL = 10.0f;  // Release tail rendered after a MIDI file ends (seconds, at most)
+constexpr size_t MIDI_MAX_TAIL_SAMPLES = static_cast<size_t>(SAMPLE_RATE * MIDI_MAX_TAIL);
+
+// Test phrase (velocity 0 = note off)
+struct NoteEvent {
+    size_t time;
+    uint8_t note;
+    uint8_t velocity;
+};
+
+const NoteEvent EVENTS[] = {
+    {0,                                                   60, 80},
+    {static_cast<size_t>(SAMPLE_RATE * 1.0f),             64, 80},
+    {static_cast<size_t>(SAMPLE_RATE * 2.0f),             67, 80},
+    {static_cast<size_t>(SAMPLE_RATE * NOTE_DURATION),    60, 0},
+    {static_cast<size_t>(SAMPLE_RATE * NOTE_DURATION),    64, 0},
+    {static_cast<size_t>(SAMPLE_RATE * NOTE_DURATION),    67, 0}
+};
+constexpr size_t NUM_EVENTS = sizeof(EVENTS) / sizeof(EVENTS[0]);
+
+// Usage: fm_synth [file.mid]
+// With a Standard MIDI File, it is rendered instead of the test phrase (program
+// changes select presets of the bank)
+int main(int argc, char** argv) {
+    const char* midiPath = (argc > 1) ? argv[1] : nullptr;
 
-int main() {
     // Initialize Look Up Tables
     LUT::init();
 
@@ -33,6 +62,7 @@ int main() {
     // -------------------------------------------------------------------------
     Synth synth = Synth();
     synth.initParams();
+    synth.loadTuning();  // tuning.scl / tuning.kbm if present, 12-TET otherwise
     
     /*
     OperatorConfig opConfigs[6] = {
@@ -117,53 +147,102 @@ int main() {
         }
     }
     printSynthConfig(presetConfig);
+
+    if (USE_EFFECTS) {
+        FxChain& effects = synth.getEffects();
+        effects.setFilter(70, 40);
+        effects.setDrive(20, 99);
+        effects.setChorus(30, 50, 40);
+        effects.setReverb(60, 40, 25);
+        effects.setEnabled(FxChain::FILTER, true);
+        effects.setEnabled(FxChain::DRIVE, true);
+        effects.setEnabled(FxChain::CHORUS, true);
+        effects.setEnabled(FxChain::REVERB, true);
+    }
     
+    MidiFile midiFile;
+    MidiPlayer player;
+    if (midiPath) {
+        if (!midiFile.load(midiPath)) return 1;
+        player.setBank(&sysex);
+    }
+
     // -------------------------------------------------------------------------
     // Generate audio
     // -------------------------------------------------------------------------
-    auto startTime = std::chrono::high_resolution_clock::now();
-    
-    std::vector<float> samples;
-    samples.reserve(TOTAL_SAMPLES);
-    
-    // Play notes
-    synth.noteOn(60, 80);
-    
-    for (size_t i = 0; i < TOTAL_SAMPLES; ++i) {
-        if (i == static_cast<size_t>(SAMPLE_RATE * 1.0f)) {
-            synth.noteOn(64, 80);
-        }
+    // Blocks are streamed to the WAV file as they are rendered (constant memory)
+    WavWriter writer;
+    if (!writer.open(FILE_NAME, static_cast<uint32_t>(SAMPLE_RATE), CHANNELS, FILE_FORMAT)) {
+        std::cerr << "ERROR: Failed to create WAV file\n";
+        return 1;
+    }
 
-        if (i == static_cast<size_t>(SAMPLE_RATE * 2.0f)) {
-            synth.noteOn(67, 80);
+    float left[BLOCK_SIZE];
+    float right[BLOCK_SIZE];
+    std::chrono::high_resolution_clock::duration renderTime{0};
+    
+    // Render in fixed blocks like the Teensy audio callback: events go through the
+    // synth's event queue, stamped with their sample time, one block ahead
+    // A MIDI file plays to its end, then until the synth is silent (bounded tail)
+    size_t nextEvent = 0;
+    size_t tailSamples = 0;
+    if (midiPath) player.start(&midiFile, synth.getSampleTime());
+    for (size_t i = 0; ; ) {
+        size_t count;
+        if (midiPath) {
+            if (player.finished()) {
+                if (synth.isIdle() || tailSamples >= MIDI_MAX_TAIL_SAMPLES) break;
+                tailSamples += BLOCK_SIZE;
+            }
+            count = player.schedule(synth, BLOCK_SIZE);
+        } else {
+            if (i >= TOTAL_SAMPLES) break;
+            while (nextEvent < NUM_EVENTS && EVENTS[nextEvent].time < i + BLOCK_SIZE) {
+                const NoteEvent& event = EVENTS[nextEvent++];
+                synth.postEvent(SynthEvent(static_cast<uint32_t>(event.time), SynthEvent::NoteOn,
+                                           event.note, event.velocity));
+            }
+            count = (TOTAL_SAMPLES - i < BLOCK_SIZE) ? TOTAL_SAMPLES - i : BLOCK_SIZE;
         }
+        i += count;
 
-        // Release note after NOTE_DURATION seconds
-        if (i == static_cast<size_t>(SAMPLE_RATE * NOTE_DURATION)) {
-            synth.noteOff(60);
-            synth.noteOff(64);
-            synth.noteOff(67);
-        }
+        const auto blockStart = std::chrono::high_resolution_clock::now();
+        if (CHANNELS == 2) synth.processBlock(left, right, count);
+        else synth.processBlock(left, count);
+        renderTime += std::chrono::high_resolution_clock::now() - blockStart;
 
-        // Process one sample
-        samples.push_back(synth.process());
+        if (CHANNELS == 2) writer.write(left, right, count);
+        else writer.write(left, count);
     }
-    
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(renderTime);
     float timeSeconds = static_cast<float>(duration.count()) / 1000000.0f;
     
     // -------------------------------------------------------------------------
-    // Write WAV file and display statistics
+    // Close WAV file and display statistics
     // -------------------------------------------------------------------------
-    if (WavWriter::writeFile(FILE_NAME, samples, static_cast<uint32_t>(SAMPLE_RATE))) {
+    const uint64_t framesWritten = writer.getFrameCount();
+    const float renderedSeconds = static_cast<float>(framesWritten) * INV_SAMPLE_RATE;
+    if (writer.close()) {
         std::cout << "=== AS7 Test ===\n";
-        std::cout << "Samples generated: " << samples.size() << "\n";
-        std::cout << "Total duration: " << TOTAL_DURATION << " seconds\n";
+        if (midiPath) {
+            std::cout << "MIDI file: " << midiPath << " (" << midiFile.getEvents().size() << " events)\n";
+        }
+        std::cout << "Samples generated: " << framesWritten << "\n";
+        std::cout << "Total duration: " << renderedSeconds << " seconds\n";
         std::cout << "Generation time: " << duration.count() << " µs\n";
-        std::cout << "Real-time factor: " << (TOTAL_DURATION / timeSeconds) << "x\n";
+        std::cout << "Real-time factor: " << (renderedSeconds / timeSeconds) << "x\n";
         std::cout << "Effective sample rate: " 
-                  << (static_cast<float>(samples.size()) / timeSeconds) << " samples/sec\n";
+                  << (static_cast<float>(framesWritten) / timeSeconds) << " samples/sec\n";
+        std::cout << "Voices culled in release: " << synth.getCulledVoiceCount() << "\n";
+        if (USE_EFFECTS) {
+            const FxChain& effects = synth.getEffects();
+            std::cout << "Effects load (% of real time): filter " << effects.getStageLoad(FxChain::FILTER)
+                      << ", drive " << effects.getStageLoad(FxChain::DRIVE)
+                      << ", chorus " << effects.getStageLoad(FxChain::CHORUS)
+                      << ", reverb " << effects.getStageLoad(FxChain::REVERB) << "\n";
+            std::cout << "Filter time per block: " << effects.getStageTicks(FxChain::FILTER, BLOCK_SIZE) << " ns\n";
+        }
         
         return 0;
     } else {
@@ -0,0 +1,245 @@
+#ifndef MIDI_FILE_H
+#define MIDI_FILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "core/constants.h"
+
+// Standard MIDI File reader (format 0 and 1)
+// All tracks are merged into one list of channel messages in time order, each
+// stamped with its sample position: the tempo map (every Set Tempo meta event,
+// whichever track holds it) is applied while loading, so playback is a plain
+// walk through the list. Meta events other than tempo and all SysEx are skipped
+class MidiFile {
+public:
+    struct Event {
+        uint64_t sample;  // Position from the start of the file, in samples
+        uint8_t status;   // Channel message status (0x80-0xEF)
+        uint8_t data1;
+        uint8_t data2;    // 0 for one-byte messages (program change, channel pressure)
+
+        uint8_t type() const { return status & 0xF0; }
+        uint8_t channel() const { return status & 0x0F; }
+    };
+
+private:
+    static constexpr uint32_t DEFAULT_TEMPO = 500000;  // Microseconds per quarter note (120 BPM)
+
+    struct TimedEvent {
+        uint64_t tick;
+        uint16_t track;
+        Event event;
+    };
+
+    struct TempoChange {
+        uint64_t tick;
+        uint32_t microsPerQuarter;
+    };
+
+    std::vector<Event> events;
+    uint16_t format = 0;
+    uint16_t trackCount = 0;
+    uint64_t lengthSamples = 0;  // Position of the last event, end of track included
+
+    static uint32_t readUint32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    static uint16_t readUint16(const uint8_t* p) {
+        return static_cast<uint16_t>((p[0] << 8) | p[1]);
+    }
+
+    // Variable-length quantity (at most 4 bytes); false past the end of the track
+    static bool readVarLen(const uint8_t*& p, const uint8_t* end, uint32_t& value) {
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (p >= end) return false;
+            const uint8_t byte = *p++;
+            value = (value << 7) | (byte & 0x7F);
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    static bool fail(const char* message) {
+        #ifdef DEBUG_PC
+        std::cerr << "Error: MIDI file " << message << std::endl;
+        #else
+        (void)message;
+        #endif
+        return false;
+    }
+
+    // One MTrk chunk: channel messages into timed, tempo changes into tempo
+    static bool parseTrack(const uint8_t* p, const uint8_t* end, uint16_t track,
+                           std::vector<TimedEvent>& timed, std::vector<TempoChange>& tempo,
+                           uint64_t& lastTick) {
+        uint64_t tick = 0;
+        uint8_t runningStatus = 0;
+
+        while (p < end) {
+            uint32_t delta;
+            if (!readVarLen(p, end, delta)) return fail("track truncated (delta time)");
+            tick += delta;
+            if (p >= end) return fail("track truncated (event)");
+
+            uint8_t status = *p;
+            if (status & 0x80) {
+                ++p;
+            } else {
+                if (!runningStatus) return fail("data byte without running status");
+                status = runningStatus;  // Running status: this byte is the first data byte
+            }
+
+            if (status == 0xFF) {
+                // Meta event: type, length, data
+                if (p >= end) return fail("track truncated (meta)");
+                const uint8_t metaType = *p++;
+                uint32_t length;
+                if (!readVarLen(p, end, length) || length > static_cast<uint32_t>(end - p)) {
+                    return fail("track truncated (meta data)");
+                }
+                if (metaType == 0x51 && length == 3) {
+                    tempo.push_back({tick, (static_cast<uint32_t>(p[0]) << 16) |
+                                           (static_cast<uint32_t>(p[1]) << 8) | p[2]});
+                }
+                p += length;
+                if (metaType == 0x2F) break;  // End of track
+            } else if (status == 0xF0 || status == 0xF7) {
+                // SysEx or escape: length, data (skipped)
+                uint32_t length;
+                if (!readVarLen(p, end, length) || length > static_cast<uint32_t>(end - p)) {
+                    return fail("track truncated (sysex)");
+                }
+                p += length;
+                runningStatus = 0;  // SysEx cancels running status
+            } else if (status >= 0xF0) {
+                return fail("system message inside a track");
+            } else {
+                const uint8_t type = status & 0xF0;
+                const size_t dataLength = (type == 0xC0 || type == 0xD0) ? 1 : 2;
+                if (static_cast<size_t>(end - p) < dataLength) return fail("track truncated (channel message)");
+                Event event;
+                event.sample = 0;
+                event.status = status;
+                event.data1 = p[0] & 0x7F;
+                event.data2 = (dataLength == 2) ? (p[1] & 0x7F) : 0;
+                p += dataLength;
+                runningStatus = status;
+                timed.push_back({tick, track, event});
+            }
+        }
+
+        if (tick > lastTick) lastTick = tick;
+        return true;
+    }
+
+public:
+    // Parse a file held in memory; on failure the previous content is kept
+    bool parse(const uint8_t* data, size_t size) {
+        if (size < 14 || std::string(reinterpret_cast<const char*>(data), 4) != "MThd") {
+            return fail("has no MThd header");
+        }
+        const uint32_t headerLength = readUint32(data + 4);
+        if (headerLength < 6 || headerLength > size - 8) return fail("header truncated");
+
+        const uint16_t fileFormat = readUint16(data + 8);
+        const uint16_t tracks = readUint16(data + 10);
+        const uint16_t division = readUint16(data + 12);
+        if (fileFormat > 1) return fail("format not supported (only 0 and 1)");
+        if (division == 0) return fail("has a zero time division");
+
+        std::vector<TimedEvent> timed;
+        std::vector<TempoChange> tempo;
+        uint64_t lastTick = 0;
+
+        // Track chunks; unknown chunk types are skipped
+        size_t offset = 8 + headerLength;
+        uint16_t track = 0;
+        while (track < tracks && offset + 8 <= size) {
+            const uint32_t chunkLength = readUint32(data + offset + 4);
+            if (chunkLength > size - offset - 8) return fail("chunk truncated");
+            const uint8_t* chunk = data + offset + 8;
+            if (std::string(reinterpret_cast<const char*>(data + offset), 4) == "MTrk") {
+                if (!parseTrack(chunk, chunk + chunkLength, track, timed, tempo, lastTick)) return false;
+                ++track;
+            }
+            offset += 8 + chunkLength;
+        }
+        if (track < tracks) return fail("has fewer tracks than its header announces");
+
+        // Merge: time order, tracks in file order at equal ticks, file order within a track
+        std::stable_sort(timed.begin(), timed.end(), [](const TimedEvent& a, const TimedEvent& b) {
+            return a.tick < b.tick || (a.tick == b.tick && a.track < b.track);
+        });
+        std::stable_sort(tempo.begin(), tempo.end(), [](const TempoChange& a, const TempoChange& b) {
+            return a.tick < b.tick;
+        });
+
+        // Ticks to seconds: SMPTE division is a fixed rate, PPQ follows the tempo map
+        const bool smpte = (division & 0x8000) != 0;
+        double secondsPerTick;
+        if (smpte) {
+            const int framesPerSecond = -static_cast<int8_t>(division >> 8);
+            const int ticksPerFrame = division & 0xFF;
+            if (framesPerSecond <= 0 || ticksPerFrame == 0) return fail("has an invalid SMPTE division");
+            // 29 means 29.97 drop frame
+            const double rate = (framesPerSecond == 29) ? 29.97 : static_cast<double>(framesPerSecond);
+            secondsPerTick = 1.0 / (rate * ticksPerFrame);
+        } else {
+            secondsPerTick = DEFAULT_TEMPO * 1e-6 / division;
+        }
+
+        // Walk events and tempo changes together, accumulating time segment by segment
+        size_t tempoIndex = 0;
+        uint64_t segmentTick = 0;
+        double segmentSeconds = 0.0;
+        auto toSample = [&](uint64_t tick) {
+            while (!smpte && tempoIndex < tempo.size() && tempo[tempoIndex].tick <= tick) {
+                segmentSeconds += static_cast<double>(tempo[tempoIndex].tick - segmentTick) * secondsPerTick;
+                segmentTick = tempo[tempoIndex].tick;
+                secondsPerTick = tempo[tempoIndex].microsPerQuarter * 1e-6 / division;
+                ++tempoIndex;
+            }
+            const double seconds = segmentSeconds + static_cast<double>(tick - segmentTick) * secondsPerTick;
+            return static_cast<uint64_t>(seconds * static_cast<double>(SAMPLE_RATE) + 0.5);
+        };
+
+        events.clear();
+        events.reserve(timed.size());
+        for (TimedEvent& item : timed) {
+            item.event.sample = toSample(item.tick);
+            events.push_back(item.event);
+        }
+        lengthSamples = toSample(lastTick);
+        format = fileFormat;
+        trackCount = tracks;
+        return true;
+    }
+
+    bool load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return fail(("not found: " + path).c_str());
+
+        std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (!parse(buffer.data(), buffer.size())) return false;
+
+        #ifdef DEBUG_PC
+        std::cout << "Loaded MIDI file: " << path << " (format " << format << ", " << trackCount
+                  << " tracks, " << events.size() << " events)" << std::endl;
+        #endif
+        return true;
+    }
+
+    const std::vector<Event>& getEvents() const { return events; }
+    uint64_t getLengthSamples() const { return lengthSamples; }
+    uint16_t getFormat() const { return format; }
+    uint16_t getTrackCount() const { return trackCount; }
+};
+
+#endif // MIDI_FILE_H
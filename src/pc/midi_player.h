@@ -0,0 +1,120 @@
+#ifndef MIDI_PLAYER_H
+#define MIDI_PLAYER_H
+
+#include <cstdint>
+#include "core/config.h"
+#include "core/synth.h"
+#include "core/sysex.h"
+#include "pc/midi_file.h"
+
+// Offline scheduler: feeds a MidiFile to a Synth block by block, as fast as the
+// caller renders
+// Channel messages go through the synth's event queue stamped with their sample
+// time, exactly as live MIDI does on Teensy. Program changes load a preset of the
+// bank (if one is set) through configure(), so a block ends at each program change
+// and the new preset starts on its sample
+class MidiPlayer {
+private:
+    const MidiFile* file = nullptr;
+    SysexHandler* bank = nullptr;
+    SynthConfig programConfig;  // Staging of program changes, kept alive for the synth
+    size_t cursor = 0;          // Next event
+    uint64_t position = 0;      // Samples scheduled so far
+    uint32_t origin = 0;        // Synth sample time of the file start
+    int8_t channel = -1;        // -1 = omni
+
+    static bool toSynthEvent(const MidiFile::Event& event, SynthEvent& out) {
+        switch (event.type()) {
+            case 0x80: out.type = SynthEvent::NoteOff; out.data1 = event.data1; out.data2 = 0; return true;
+            case 0x90: out.type = SynthEvent::NoteOn; out.data1 = event.data1; out.data2 = event.data2; return true;
+            case 0xB0: out.type = SynthEvent::ControlChange; out.data1 = event.data1; out.data2 = event.data2; return true;
+            case 0xE0:
+                out.type = SynthEvent::PitchBend;
+                out.data1 = 0;
+                out.data2 = static_cast<uint16_t>((event.data2 << 7) | event.data1);
+                return true;
+            default: return false;  // Aftertouch and channel pressure are not used
+        }
+    }
+
+    void programChange(Synth& synth, uint8_t program) {
+        if (!bank || !bank->loadPreset(&programConfig, static_cast<uint8_t>(program % 32))) return;
+        synth.configure(&programConfig);
+        #ifdef DEBUG_PC
+        std::cout << "Program change: " << static_cast<int>(program % 32) << " "
+                  << bank->getPresetName(static_cast<uint8_t>(program % 32)) << std::endl;
+        #endif
+    }
+
+public:
+    // Presets for program changes (program modulo 32), nullptr to ignore them
+    void setBank(SysexHandler* sysexBank) { bank = sysexBank; }
+
+    // MIDI channel 1-16, 0 = omni
+    void setChannel(uint8_t midiChannel) {
+        channel = (midiChannel >= 1 && midiChannel <= 16) ? static_cast<int8_t>(midiChannel - 1) : -1;
+    }
+
+    // Play from the start of file; its time 0 is the synth's current sample time
+    void start(const MidiFile* midiFile, uint32_t synthTime) {
+        file = midiFile;
+        cursor = 0;
+        position = 0;
+        origin = synthTime;
+    }
+
+    // Queue the events of the next block of up to n samples and return the block
+    // length to render now: shorter than n before a program change or when the
+    // event queue is full. The caller renders exactly that many samples
+    size_t schedule(Synth& synth, size_t n) {
+        synth.flushConfig();
+        uint64_t end = position + n;
+        if (!file) {
+            position = end;
+            return n;
+        }
+
+        const std::vector<MidiFile::Event>& events = file->getEvents();
+        while (cursor < events.size() && events[cursor].sample < end) {
+            const MidiFile::Event& event = events[cursor];
+            if (channel >= 0 && event.channel() != channel) {
+                ++cursor;
+                continue;
+            }
+
+            if (event.type() == 0xC0) {
+                if (event.sample > position) {
+                    end = event.sample;  // Render up to the change first
+                    break;
+                }
+                programChange(synth, event.data1);
+                ++cursor;
+                continue;
+            }
+
+            SynthEvent out;
+            if (toSynthEvent(event, out)) {
+                out.time = origin + static_cast<uint32_t>(event.sample);
+                if (!synth.postEvent(out)) {
+                    // Queue full: render what is queued and retry this event
+                    end = (event.sample > position) ? event.sample : position + 1;
+                    break;
+                }
+            }
+            ++cursor;
+        }
+
+        const size_t count = static_cast<size_t>(end - position);
+        position = end;
+        return count;
+    }
+
+    // All events have been scheduled and the file length has been reached
+    bool finished() const {
+        return !file || (cursor >= file->getEvents().size() && position >= file->getLengthSamples());
+    }
+
+    uint64_t getPosition() const { return position; }
+};
+
+#endif // MIDI_PLAYER_H
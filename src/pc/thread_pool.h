@@ -0,0 +1,90 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool for batches of independent jobs (offline renders)
+// Jobs 0..count-1 are dealt out in contiguous runs, one deque per worker. A worker
+// takes its own jobs from the back and, once its deque is empty, steals from the
+// front of the others, so long jobs on one worker are picked up by idle ones.
+// No job is added during a batch: a worker that finds every deque empty is done
+class WorkStealingPool {
+private:
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<size_t> jobs;
+    };
+
+    size_t workerCount;
+    std::vector<WorkQueue> queues;
+    std::atomic<size_t> stolenJobs{0};
+
+    bool popLocal(size_t worker, size_t& job) {
+        WorkQueue& queue = queues[worker];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.jobs.empty()) return false;
+        job = queue.jobs.back();
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    bool steal(size_t worker, size_t& job) {
+        for (size_t i = 1; i < workerCount; ++i) {
+            WorkQueue& victim = queues[(worker + i) % workerCount];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (victim.jobs.empty()) continue;
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            stolenJobs.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+public:
+    // workers = 0: one per hardware thread
+    explicit WorkStealingPool(size_t workers = 0)
+        : workerCount(workers ? workers : std::max<size_t>(1, std::thread::hardware_concurrency())),
+          queues(workerCount) {}
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t getWorkerCount() const { return workerCount; }
+
+    // Jobs taken from another worker's deque during the last run()
+    size_t getStolenJobs() const { return stolenJobs.load(std::memory_order_relaxed); }
+
+    // Run job(index, worker) for every index in [0, count) and wait for all of them
+    // The worker index (0..getWorkerCount()-1) selects per-worker state: no two
+    // jobs run at the same time on one worker
+    template<typename Job>
+    void run(size_t count, Job job) {
+        stolenJobs.store(0, std::memory_order_relaxed);
+        for (size_t w = 0; w < workerCount; ++w) {
+            const size_t first = count * w / workerCount;
+            const size_t last = count * (w + 1) / workerCount;
+            // Reversed: the owner pops from the back, so it runs its run in order
+            for (size_t i = last; i > first; --i) queues[w].jobs.push_back(i - 1);
+        }
+
+        auto work = [this, &job](size_t worker) {
+            size_t index;
+            while (popLocal(worker, index) || steal(worker, index)) job(index, worker);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workerCount - 1);
+        for (size_t w = 1; w < workerCount; ++w) threads.emplace_back(work, w);
+        work(0);  // The calling thread is worker 0
+        for (std::thread& thread : threads) thread.join();
+    }
+};
+
+#endif // THREAD_POOL_H
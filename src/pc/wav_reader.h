@@ -0,0 +1,97 @@
+#ifndef WAV_READER_H
+#define WAV_READER_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Lecture des fichiers WAV écrits par WavWriter (rendus de référence, comparaisons)
+// RIFF ou RF64, float 32-bit, PCM 16 ou 24-bit ; les chunks inconnus sont ignorés
+class WavReader {
+private:
+    static uint32_t readUint32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    static uint16_t readUint16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    static uint64_t readUint64(const uint8_t* p) {
+        return static_cast<uint64_t>(readUint32(p)) | (static_cast<uint64_t>(readUint32(p + 4)) << 32);
+    }
+
+public:
+    /**
+     * Lit un fichier WAV complet
+     * @param filename Nom du fichier
+     * @param samples Échantillons entrelacés, convertis en float entre -1.0 et 1.0
+     * @param channels Nombre de canaux
+     * @param sampleRate Fréquence d'échantillonnage
+     * @return true si succès, false si le fichier est absent, tronqué ou d'un format non supporté
+     */
+    static bool read(const std::string& filename, std::vector<float>& samples,
+                     uint16_t& channels, uint32_t& sampleRate) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) return false;
+        const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (data.size() < 12) return false;
+
+        const bool rf64 = std::memcmp(data.data(), "RF64", 4) == 0;
+        if ((!rf64 && std::memcmp(data.data(), "RIFF", 4) != 0) || std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+            return false;
+        }
+
+        uint16_t format = 0;
+        uint16_t bits = 0;
+        channels = 0;
+        uint64_t dataSize64 = 0;  // Taille du chunk data d'un fichier RF64 (ds64)
+
+        size_t offset = 12;
+        while (offset + 8 <= data.size()) {
+            const uint8_t* chunk = data.data() + offset;
+            uint64_t size = readUint32(chunk + 4);
+
+            if (std::memcmp(chunk, "ds64", 4) == 0 && size >= 24 && offset + 8 + 24 <= data.size()) {
+                dataSize64 = readUint64(chunk + 16);
+            } else if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16 && offset + 8 + 16 <= data.size()) {
+                format = readUint16(chunk + 8);
+                channels = readUint16(chunk + 10);
+                sampleRate = readUint32(chunk + 12);
+                bits = readUint16(chunk + 22);
+            } else if (std::memcmp(chunk, "data", 4) == 0) {
+                if (rf64 && size == 0xFFFFFFFFu) size = dataSize64;
+                if (size > data.size() - offset - 8) size = data.size() - offset - 8;  // Fichier interrompu
+
+                const bool float32 = (format == 3 && bits == 32);
+                const bool pcm = (format == 1 && (bits == 16 || bits == 24));
+                if (channels == 0 || (!float32 && !pcm)) return false;
+
+                const size_t bytesPerSample = bits / 8;
+                const size_t count = static_cast<size_t>(size) / bytesPerSample;
+                const uint8_t* p = chunk + 8;
+                samples.assign(count, 0.0f);
+                for (size_t i = 0; i < count; ++i, p += bytesPerSample) {
+                    if (float32) {
+                        std::memcpy(&samples[i], p, 4);
+                    } else if (bits == 16) {
+                        samples[i] = static_cast<float>(static_cast<int16_t>(readUint16(p))) * (1.0f / 32767.0f);
+                    } else {
+                        const int32_t value = static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 8) |
+                                                                   (static_cast<uint32_t>(p[1]) << 16) |
+                                                                   (static_cast<uint32_t>(p[2]) << 24)) >> 8;
+                        samples[i] = static_cast<float>(value) * (1.0f / 8388607.0f);
+                    }
+                }
+                return true;
+            }
+            offset += 8 + static_cast<size_t>(size) + static_cast<size_t>(size & 1);
+        }
+        return false;
+    }
+};
+
+#endif
@@ -4,14 +4,43 @@
 #include <fstream>
 #include <vector>
 #include <cstdint>
+#include <cstring>
 #include <string>
+#include "core/sample_format.h"
 
+// Écriture WAV en flux : les blocs rendus sont ajoutés au fil de l'eau (mémoire constante)
+// - tampon de sortie de BUFFER_SIZE octets, vidé quand il est plein
+// - en-tête mis à jour tous les PATCH_INTERVAL octets : un fichier interrompu reste lisible
+// - au-delà de 4 Go, l'en-tête passe en RF64 (EBU Tech 3306) : le chunk JUNK réservé
+//   à l'ouverture devient le chunk ds64 qui porte les tailles 64-bit
 class WavWriter {
+public:
+    enum Format : uint8_t {
+        FLOAT32 = 0,  // IEEE float 32-bit
+        PCM16,        // Entier 16-bit (conversion SampleFormat, dither TPDF optionnel)
+        PCM24         // Entier 24-bit (idem)
+    };
+
 private:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;        // Tampon de sortie (octets)
+    static constexpr uint64_t PATCH_INTERVAL = 1u << 20;   // Mise à jour de l'en-tête (octets de données)
+    static constexpr size_t CONVERT_BLOCK = 1024;           // Échantillons convertis par passe
+    static constexpr uint32_t HEADER_SIZE = 80;             // RIFF 12 + JUNK/ds64 36 + fmt 24 + data 8
+    static constexpr uint32_t DS64_SIZE = 28;
+    static constexpr uint64_t RIFF_MAX = 0xFFFFFFFFu;       // Limite des tailles 32-bit
+
     std::ofstream file;
+    Format format = FLOAT32;
+    uint16_t channels = 1;
+    uint16_t bytesPerSample = 4;
+    bool ditherEnabled = true;
+    SampleFormat::Dither dither;
+
+    std::vector<char> buffer;
+    size_t bufferUsed = 0;
+    uint64_t dataBytes = 0;       // Données écrites (tampon compris)
+    uint64_t patchedBytes = 0;    // Données couvertes par le dernier en-tête (tampon vide)
 
-    WavWriter() = default;
-    
     // Écrit un entier 32-bit en little-endian
     void writeUint32(uint32_t value) {
         file.put(static_cast<char>(value & 0xFF));
@@ -19,100 +48,226 @@ private:
         file.put(static_cast<char>((value >> 16) & 0xFF));
         file.put(static_cast<char>((value >> 24) & 0xFF));
     }
-    
+
     // Écrit un entier 16-bit en little-endian
     void writeUint16(uint16_t value) {
         file.put(static_cast<char>(value & 0xFF));
         file.put(static_cast<char>((value >> 8) & 0xFF));
     }
-    
+
+    // Écrit un entier 64-bit en little-endian
+    void writeUint64(uint64_t value) {
+        writeUint32(static_cast<uint32_t>(value & 0xFFFFFFFFu));
+        writeUint32(static_cast<uint32_t>(value >> 32));
+    }
+
+    void flushBuffer() {
+        if (bufferUsed == 0) return;
+        file.write(buffer.data(), static_cast<std::streamsize>(bufferUsed));
+        bufferUsed = 0;
+    }
+
+    // Réécrit les tailles de l'en-tête (RIFF ou RF64) pour les données déjà sur disque
+    // padding : octet de bourrage final d'un chunk data de taille impaire
+    void patchHeader(uint32_t padding = 0) {
+        const uint64_t riffSize = HEADER_SIZE - 8 + dataBytes + padding;
+        const bool large = riffSize > RIFF_MAX;
+
+        file.seekp(0, std::ios::beg);
+        file.write(large ? "RF64" : "RIFF", 4);
+        writeUint32(large ? 0xFFFFFFFFu : static_cast<uint32_t>(riffSize));
+
+        file.seekp(12, std::ios::beg);
+        file.write(large ? "ds64" : "JUNK", 4);
+        writeUint32(DS64_SIZE);
+        if (large) {
+            writeUint64(riffSize);
+            writeUint64(dataBytes);
+            writeUint64(getFrameCount());
+            writeUint32(0);  // Pas de table de chunks
+        }
+
+        file.seekp(HEADER_SIZE - 4, std::ios::beg);
+        writeUint32(large ? 0xFFFFFFFFu : static_cast<uint32_t>(dataBytes));
+
+        file.seekp(0, std::ios::end);
+        file.flush();
+        patchedBytes = dataBytes;
+    }
+
+    // Ajoute des échantillons entrelacés au tampon, convertis au format du fichier
+    void append(const float* samples, size_t count) {
+        int16_t converted16[CONVERT_BLOCK];
+        int32_t converted24[CONVERT_BLOCK];
+        SampleFormat::Dither* noise = ditherEnabled ? &dither : nullptr;
+
+        for (size_t i = 0; i < count; i += CONVERT_BLOCK) {
+            const size_t n = (count - i < CONVERT_BLOCK) ? count - i : CONVERT_BLOCK;
+            const size_t bytes = n * bytesPerSample;
+            if (bufferUsed + bytes > buffer.size()) {
+                flushBuffer();
+                if (dataBytes - patchedBytes >= PATCH_INTERVAL) patchHeader();
+            }
+            char* out = buffer.data() + bufferUsed;
+
+            switch (format) {
+                case PCM16:
+                    SampleFormat::toInt16(samples + i, converted16, n, 1.0f, noise);
+                    std::memcpy(out, converted16, bytes);
+                    break;
+                case PCM24:
+                    SampleFormat::toInt24(samples + i, converted24, n, 1.0f, noise);
+                    for (size_t j = 0; j < n; ++j) {
+                        const uint32_t value = static_cast<uint32_t>(converted24[j]);
+                        out[3 * j] = static_cast<char>(value & 0xFF);
+                        out[3 * j + 1] = static_cast<char>((value >> 8) & 0xFF);
+                        out[3 * j + 2] = static_cast<char>((value >> 16) & 0xFF);
+                    }
+                    break;
+                default:
+                    std::memcpy(out, samples + i, bytes);
+                    break;
+            }
+            bufferUsed += bytes;
+            dataBytes += bytes;
+        }
+    }
+
 public:
+    WavWriter() = default;
+
+    ~WavWriter() {
+        close();
+    }
+
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
     /**
      * Ouvre un fichier WAV pour écriture
      * @param filename Nom du fichier de sortie
      * @param sampleRate Fréquence d'échantillonnage (ex: 44100)
+     * @param channelCount Nombre de canaux (1 = mono, 2 = stéréo)
+     * @param fileFormat Format des échantillons (float 32-bit, PCM 16 ou 24-bit)
+     * @param useDither Dither TPDF avant l'arrondi en entier
      * @return true si succès, false sinon
      */
-    bool open(const std::string& filename, uint32_t sampleRate = 44100) {
-        file.open(filename, std::ios::binary);
+    bool open(const std::string& filename, uint32_t sampleRate = 44100, uint16_t channelCount = 1,
+              Format fileFormat = FLOAT32, bool useDither = true) {
+        close();
+        if (channelCount == 0) return false;
+        file.open(filename, std::ios::binary | std::ios::trunc);
         if (!file.is_open()) {
             return false;
         }
-        
-        // Écrit l'en-tête WAV (format float 32-bit)
-        const char riff[] = {'R', 'I', 'F', 'F'};
-        file.write(riff, 4);
-        writeUint32(0);  // Taille fichier - 8 (à remplir à la fin)
-        
-        const char wave[] = {'W', 'A', 'V', 'E'};
-        file.write(wave, 4);
-        
-        const char fmt[] = {'f', 'm', 't', ' '};
-        file.write(fmt, 4);
+        format = fileFormat;
+        channels = channelCount;
+        bytesPerSample = (format == PCM16) ? 2 : (format == PCM24) ? 3 : 4;
+        ditherEnabled = useDither;
+        buffer.resize(BUFFER_SIZE);
+        bufferUsed = 0;
+        dataBytes = 0;
+        patchedBytes = 0;
+
+        // Écrit l'en-tête WAV (tailles à 0, mises à jour au fil de l'écriture)
+        file.write("RIFF", 4);
+        writeUint32(0);  // Taille fichier - 8
+        file.write("WAVE", 4);
+
+        // Place réservée au chunk ds64 (RF64)
+        file.write("JUNK", 4);
+        writeUint32(DS64_SIZE);
+        for (uint32_t i = 0; i < DS64_SIZE; ++i) file.put(0);
+
+        const uint16_t blockAlign = static_cast<uint16_t>(channels * bytesPerSample);
+        file.write("fmt ", 4);
         writeUint32(16);  // Taille du chunk fmt (16 pour PCM)
-        
-        writeUint16(3);   // Format audio (3 = float 32-bit IEEE)
-        writeUint16(1);   // Nombre de canaux (mono)
+        writeUint16((format == FLOAT32) ? 3 : 1);  // Format audio (1 = PCM, 3 = float 32-bit IEEE)
+        writeUint16(channels);    // Nombre de canaux
         writeUint32(sampleRate);  // Fréquence d'échantillonnage
-        writeUint32(sampleRate * 4);  // Byte rate (sampleRate * canaux * 4)
-        writeUint16(4);   // Block align (canaux * 4)
-        writeUint16(32);  // Bits par échantillon (32 pour float)
-        
-        const char data[] = {'d', 'a', 't', 'a'};
-        file.write(data, 4);
-        writeUint32(0);  // Taille données (à remplir à la fin)
-        
-        return true;
+        writeUint32(sampleRate * blockAlign);  // Byte rate (sampleRate * canaux * octets)
+        writeUint16(blockAlign);  // Block align (canaux * octets)
+        writeUint16(static_cast<uint16_t>(bytesPerSample * 8));  // Bits par échantillon
+
+        file.write("data", 4);
+        writeUint32(0);  // Taille données
+
+        return file.good();
+    }
+
+    /**
+     * Ajoute des trames entrelacées (canaux échantillons par trame)
+     * @param samples Échantillons float entre -1.0 et 1.0
+     * @param frames Nombre de trames
+     * @return false si une écriture a échoué
+     */
+    bool write(const float* samples, size_t frames) {
+        if (!file.is_open()) return false;
+        append(samples, frames * channels);
+        return file.good();
     }
-    
+
     /**
-     * Écrit des échantillons audio dans le fichier
-     * @param samples Vecteur d'échantillons (float entre -1.0 et 1.0)
+     * Ajoute des trames stéréo à partir de deux blocs séparés (Synth::processBlock)
      */
-    void writeSamples(const std::vector<float>& samples) {
-        file.write(reinterpret_cast<const char*>(samples.data()), 
-                   samples.size() * sizeof(float));
+    bool write(const float* left, const float* right, size_t frames) {
+        if (!file.is_open() || channels != 2) return false;
+        float interleaved[CONVERT_BLOCK];
+        for (size_t i = 0; i < frames; i += CONVERT_BLOCK / 2) {
+            const size_t n = (frames - i < CONVERT_BLOCK / 2) ? frames - i : CONVERT_BLOCK / 2;
+            for (size_t j = 0; j < n; ++j) {
+                interleaved[2 * j] = left[i + j];
+                interleaved[2 * j + 1] = right[i + j];
+            }
+            append(interleaved, 2 * n);
+        }
+        return file.good();
+    }
+
+    uint64_t getFrameCount() const {
+        return dataBytes / (static_cast<uint64_t>(channels) * bytesPerSample);
+    }
+
+    bool isOpen() const {
+        return file.is_open();
     }
-    
+
     /**
-     * Ferme le fichier et met à jour les tailles dans l'en-tête
+     * Vide le tampon, finalise l'en-tête et ferme le fichier
+     * @return false si une écriture a échoué
      */
-    void close() {
+    bool close() {
         if (!file.is_open()) {
-            return;
+            return true;
         }
-        
-        // Position actuelle = fin des données
-        std::streampos dataEnd = file.tellp();
-        
-        // Calcule la taille des données audio
-        uint32_t dataSize = static_cast<uint32_t>(dataEnd) - 44;
-        
-        // Retourne au début pour écrire les tailles
-        file.seekp(4, std::ios::beg);
-        writeUint32(dataSize + 36);  // Taille fichier - 8
-        
-        file.seekp(40, std::ios::beg);
-        writeUint32(dataSize);  // Taille données audio
-        
+
+        flushBuffer();
+        const uint32_t padding = static_cast<uint32_t>(dataBytes & 1);  // Chunks RIFF de taille paire
+        if (padding) file.put(0);
+        patchHeader(padding);
+
+        const bool ok = file.good();
         file.close();
+        buffer.clear();
+        buffer.shrink_to_fit();
+        return ok;
     }
-    
+
     /**
-     * Méthode statique utilitaire pour écrire un fichier en une ligne
+     * Méthode statique utilitaire pour écrire un fichier mono en une ligne
      */
-    static bool writeFile(const std::string& filename, 
+    static bool writeFile(const std::string& filename,
                          const std::vector<float>& samples,
-                         uint32_t sampleRate = 44100) {
+                         uint32_t sampleRate = 44100,
+                         Format fileFormat = FLOAT32) {
         WavWriter writer;
-        if (!writer.open(filename, sampleRate)) {
+        if (!writer.open(filename, sampleRate, 1, fileFormat)) {
             return false;
         }
-        
-        writer.writeSamples(samples);
-        writer.close();
-        return true;
+
+        writer.write(samples.data(), samples.size());
+        return writer.close();
     }
 };
 
-#endif
\ No newline at end of file
+#endif
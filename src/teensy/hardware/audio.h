@@ -3,33 +3,57 @@
 
 #include <Audio.h>
 #include "../../core/synth.h"
+#include "../../core/sample_format.h"
+#include "audio_clock.h"
 
 // Audio output stream - generates samples from synthesizer
+// Stereo: output 0 = left, output 1 = right
 class AudioOutput : public AudioStream {
 private:
     Synth* synth;
     float volume = 0.9f;
+    float bufferLeft[AUDIO_BLOCK_SAMPLES];
+    float bufferRight[AUDIO_BLOCK_SAMPLES];
+    SampleFormat::Dither dither;
+    bool ditherEnabled = true;  // TPDF dither on the 16-bit DAC output
+
+    // Block counters, written by the audio interrupt
+    volatile uint32_t idleBlocks = 0;
+    volatile uint32_t totalBlocks = 0;
 
 public:
     AudioOutput(Synth* synthPtr) : AudioStream(0, nullptr), synth(synthPtr) {}
 
     // Generate a samples buffer
     virtual void update(void) override {
-        audio_block_t* block = allocate();
-        if (!block) return;
-
-        for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
-            float sample = synth->process() * volume;
-            
-            // Clamp + convert to int16
-            if (sample > 1.0f) sample = 1.0f;
-            else if (sample < -1.0f) sample = -1.0f;
-            
-            block->data[i] = (int16_t)(sample * 32767.0f);
+        audio_block_t* left = allocate();
+        if (!left) return;
+        audio_block_t* right = allocate();
+        if (!right) {
+            release(left);
+            return;
+        }
+
+        ++totalBlocks;
+        AudioClock::markBlock(synth->getSampleTime());
+
+        // Nothing playing: zeroed blocks, no synthesis and no conversion
+        if (synth->isIdle()) {
+            synth->skipBlock(AUDIO_BLOCK_SAMPLES);
+            memset(left->data, 0, sizeof(left->data));
+            memset(right->data, 0, sizeof(right->data));
+            ++idleBlocks;
+        } else {
+            synth->processBlock(bufferLeft, bufferRight, AUDIO_BLOCK_SAMPLES);
+            SampleFormat::Dither* noise = ditherEnabled ? &dither : nullptr;
+            SampleFormat::toInt16(bufferLeft, left->data, AUDIO_BLOCK_SAMPLES, volume, noise);
+            SampleFormat::toInt16(bufferRight, right->data, AUDIO_BLOCK_SAMPLES, volume, noise);
         }
 
-        transmit(block);
-        release(block);
+        transmit(left, 0);
+        transmit(right, 1);
+        release(left);
+        release(right);
     }
 
     void setVolume(float v) {
@@ -39,6 +63,21 @@ public:
     float getVolume() const {
         return volume;
     }
+
+    void setDither(bool enabled) {
+        ditherEnabled = enabled;
+    }
+
+    // Share of blocks since the last call that took the idle path, in percent
+    float takeIdlePercent() {
+        AudioNoInterrupts();
+        const uint32_t idle = idleBlocks;
+        const uint32_t total = totalBlocks;
+        idleBlocks = 0;
+        totalBlocks = 0;
+        AudioInterrupts();
+        return total ? 100.0f * static_cast<float>(idle) / static_cast<float>(total) : 0.0f;
+    }
 };
 
 // Audio manager - handles initialization and configuration
@@ -61,11 +100,11 @@ namespace Audio {
         // Create audio output generator connected to synth
         output = new AudioOutput(synth);
         
-        // Connect mono output to I2S stereo (duplicate left=right)
+        // Connect stereo output to I2S
         // Output channel 0 → I2S left channel
         new AudioConnection(*output, 0, i2s_out, 0);
-        // Output channel 0 → I2S right channel  
-        new AudioConnection(*output, 0, i2s_out, 1);
+        // Output channel 1 → I2S right channel
+        new AudioConnection(*output, 1, i2s_out, 1);
 
         // Enable SGTL5000 codec (power on DAC/analog circuits)
         sgtl5000.enable();
@@ -87,6 +126,15 @@ namespace Audio {
     float getVolume() {
         return output ? output->getVolume() : 0.0f;
     }
+
+    void setDither(bool enabled) {
+        if (output) output->setDither(enabled);
+    }
+
+    // Idle share of audio blocks since the last call (percent)
+    float takeIdlePercent() {
+        return output ? output->takeIdlePercent() : 0.0f;
+    }
 }
 
 #endif // AUDIO_H
@@ -0,0 +1,36 @@
+#ifndef AUDIO_CLOCK_H
+#define AUDIO_CLOCK_H
+
+#include <Arduino.h>
+#include <Audio.h>
+
+// Maps control-loop time (micros) to the synth's sample clock
+// The audio interrupt marks the start of each block; control events are stamped
+// one block later than their arrival, so their spacing is kept sample-accurate
+// instead of being quantised to audio blocks
+namespace AudioClock {
+    static volatile uint32_t blockSampleTime = 0;  // Synth sample time at the last block start
+    static volatile uint32_t blockMicros = 0;      // micros() at the last block start
+
+    // Audio interrupt: a block starting at sampleTime is about to be rendered
+    inline void markBlock(uint32_t sampleTime) {
+        blockSampleTime = sampleTime;
+        blockMicros = micros();
+    }
+
+    // Control loop: sample time for an event arriving now
+    inline uint32_t eventTime() {
+        AudioNoInterrupts();
+        const uint32_t sampleTime = blockSampleTime;
+        const uint32_t elapsedMicros = micros() - blockMicros;
+        AudioInterrupts();
+
+        // 44.1 samples per ms; at most one block late, past that the event is simply due
+        const uint32_t blockSamples = static_cast<uint32_t>(AUDIO_BLOCK_SAMPLES);
+        uint32_t elapsed = elapsedMicros * 441u / 10000u;
+        if (elapsed > blockSamples) elapsed = blockSamples;
+        return sampleTime + blockSamples + elapsed;
+    }
+}
+
+#endif // AUDIO_CLOCK_H
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "../../core/synth.h"
+#include "audio_clock.h"
 
 // MIDI message decoder and handler
 class MidiHandler {
@@ -17,8 +18,18 @@ private:
     // Message handlers
     // ================
     
+    // Events go to the synth's queue, stamped on the audio sample clock:
+    // the audio interrupt applies them, never this loop
+    void post(SynthEvent::Type type, uint8_t data1, uint16_t data2) {
+        if (!synth->postEvent(SynthEvent(AudioClock::eventTime(), type, data1, data2))) {
+            #ifdef DEBUG_TEENSY
+            Serial.println(F("MIDI - event queue full, event dropped"));
+            #endif
+        }
+    }
+    
     void handleNoteOn(uint8_t note, uint8_t velocity) {
-        synth->noteOn(note, velocity);
+        post(SynthEvent::NoteOn, note, velocity);
         #ifdef DEBUG_TEENSY
         Serial.print(F("NOTE ON  - Note: "));
         Serial.print(note);
@@ -28,7 +39,7 @@ private:
     }
     
     void handleNoteOff(uint8_t note, uint8_t velocity) {
-        synth->noteOff(note);
+        post(SynthEvent::NoteOff, note, velocity);
         #ifdef DEBUG_TEENSY
         Serial.print(F("NOTE OFF - Note: "));
         Serial.println(note);
@@ -36,8 +47,7 @@ private:
     }
     
     void handlePitchBend(uint8_t lsb, uint8_t msb) {
-        // TODO: Implement pitch bend modulation
-        // int16_t bend = ((msb << 7) | lsb) - 8192; // -8192 to +8192
+        post(SynthEvent::PitchBend, 0, static_cast<uint16_t>((msb << 7) | lsb));
         #ifdef DEBUG_TEENSY
         int16_t bend = ((msb << 7) | lsb) - 8192;
         Serial.print(F("PITCH BEND - Value: "));
@@ -46,7 +56,7 @@ private:
     }
     
     void handleModulation(uint8_t value) {
-        // TODO: Implement modulation depth control
+        post(SynthEvent::ControlChange, 0x01, value);
         #ifdef DEBUG_TEENSY
         Serial.print(F("MOD - Value: "));
         Serial.println(value);
@@ -127,6 +137,8 @@ private:
                 if (dataBytes[0] == 0x01) {
                     // CC#1 = Modulation
                     handleModulation(dataBytes[1]);
+                } else {
+                    post(SynthEvent::ControlChange, dataBytes[0], dataBytes[1]);
                 }
                 break;
         }
@@ -57,6 +57,9 @@ void setup() {
     Serial.println(F("AS7 Core Initializing..."));
     LUT::init();
     synth.initParams();
+    if (synth.loadTuning()) {
+        Serial.println(F("Tuning loaded from SD card"));
+    }
     
     // Load ROM1A bank and first preset
     if (sysex.loadBank("/presets/ROM1A_Master.syx")) {
@@ -137,6 +140,16 @@ void loop() {
         uiManager->update();
     }
 
+    // Publish a config edit the audio side was not ready for yet
+    synth.flushConfig();
+
+    // Adapt polyphony to the audio CPU load
+    static unsigned long lastGovernorUpdate = 0;
+    if (millis() - lastGovernorUpdate >= 100) {
+        lastGovernorUpdate = millis();
+        synth.reportCpuLoad(AudioProcessorUsage());
+    }
+
     #ifdef DEBUG_TEENSY
     // Monitor CPU usage periodically
     static unsigned long lastCpuCheck = 0;
@@ -163,5 +176,39 @@ void loop() {
             AudioProcessorUsageMaxReset();
         }
     }
+
+    // Report voice limit changes
+    static uint8_t lastVoiceLimit = 0;
+    if (synth.getVoiceLimit() != lastVoiceLimit) {
+        lastVoiceLimit = synth.getVoiceLimit();
+        Serial.print(F("Voice limit: "));
+        Serial.print(lastVoiceLimit);
+        Serial.print(F(" (voices shed: "));
+        Serial.print(synth.getShedVoiceCount());
+        Serial.println(F(")"));
+    }
+
+    // Report how much of the time the synth had nothing to render
+    static unsigned long lastIdleReport = 0;
+    if (now - lastIdleReport >= 5000) {
+        lastIdleReport = now;
+        Serial.print(F("Audio idle: "));
+        Serial.print(Audio::takeIdlePercent());
+        Serial.println(F("%"));
+
+        // Effects cost per stage (0 when bypassed)
+        const FxChain& effects = synth.getEffects();
+        Serial.print(F("Effects load: filter "));
+        Serial.print(effects.getStageLoad(FxChain::FILTER));
+        Serial.print(F("% ("));
+        Serial.print(effects.getStageTicks(FxChain::FILTER, AUDIO_BLOCK_SAMPLES));
+        Serial.print(F(" cycles/block), drive "));
+        Serial.print(effects.getStageLoad(FxChain::DRIVE));
+        Serial.print(F("%, chorus "));
+        Serial.print(effects.getStageLoad(FxChain::CHORUS));
+        Serial.print(F("%, reverb "));
+        Serial.print(effects.getStageLoad(FxChain::REVERB));
+        Serial.println(F("%"));
+    }
     #endif
 }
\ No newline at end of file
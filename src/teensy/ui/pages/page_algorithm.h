@@ -73,13 +73,16 @@ public:
     }
     
     void handleEncoder(uint8_t encoderIndex, int8_t direction) override {
+        if (!config || !synth) return;
+
         if (encoderIndex == 0) {
             int16_t newAlgo = static_cast<int16_t>(currentAlgorithm) + direction;
             newAlgo = constrain(newAlgo, 0, 31);
             
             if (newAlgo != currentAlgorithm) {
                 currentAlgorithm = static_cast<uint8_t>(newAlgo);
-                synth->setAlgorithm(Algorithms::ALL_ALGORITHMS[currentAlgorithm]);
+                config->voiceConfig.algorithm = Algorithms::ALL_ALGORITHMS[currentAlgorithm];
+                synth->updateConfig(config);
                 dirtyWidget = 0;  // Also triggers diagram update (position 2)
             }
             
@@ -89,7 +92,8 @@ public:
             
             if (newFb != currentFeedback) {
                 currentFeedback = static_cast<uint8_t>(newFb);
-                synth->setFeedback(currentFeedback);
+                config->voiceConfig.feedback = currentFeedback;
+                synth->updateConfig(config);
                 dirtyWidget = 1;
             }
         }
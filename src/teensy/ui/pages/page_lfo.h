@@ -72,7 +72,9 @@ public:
                 
             case 6:  // OSC Key Sync (toggle) - applies to all operators
                 oscKeySync = !oscKeySync;
-                synth->setOSCKeySync(oscKeySync);
+                for (size_t i = 0; i < NUM_OPERATORS; ++i) {
+                    config->voiceConfig.operatorConfigs[i].OSCKeySync = oscKeySync;
+                }
                 dirtyWidget = 6;
                 break;
                 
@@ -82,6 +84,9 @@ public:
                 dirtyWidget = 7;
                 break;
         }
+
+        // Publish the edited config (applied at the next audio block)
+        synth->updateConfig(config);
     }
     
     bool handleButton(uint8_t button) override {
@@ -293,8 +293,8 @@ public:
                 break;
         }
         
-        // Apply changes to synth
-        synth->configure(config);
+        // Publish the edited config (applied at the next audio block, notes keep sounding)
+        synth->updateConfig(config);
     }
     
     bool handleButton(uint8_t buttonIndex) override {
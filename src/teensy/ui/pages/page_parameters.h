@@ -9,7 +9,7 @@
 // Page for editing global synthesizer parameters
 // Grid layout (4x2):
 //   [0:PitchMod] [1:AmpMod] [2:EGBias] [3:ModIntens]
-//   [4:PitchBend] [5:unused] [6:unused] [7:MidiChan]
+//   [4:PitchBend] [5:Porta] [6:Unison] [7:MidiChan]
 class PageParameters : public Page {
 private:
     // Temporary values (not saved until user presses PARAMETERS button)
@@ -18,6 +18,8 @@ private:
     bool egBias;
     uint8_t modIntensity;
     uint8_t pitchBendRange;
+    uint8_t portamentoTime;
+    uint8_t unisonVoices;
     uint8_t midiChannel;
     
     // Widget descriptors (declarative layout)
@@ -29,8 +31,8 @@ private:
         {"ModIntens", WidgetType::KNOB, 3, &modIntensity, 0, 99},
         // Row 1
         {"PitchBend", WidgetType::KNOB, 4, &pitchBendRange, 0, 24},
-        {"", WidgetType::KNOB, 5, nullptr, 0, 0},  // Unused
-        {"", WidgetType::KNOB, 6, nullptr, 0, 0},  // Unused
+        {"Porta", WidgetType::KNOB, 5, &portamentoTime, 0, 99},  // 0=off
+        {"Unison", WidgetType::KNOB, 6, &unisonVoices, 1, UNISON_MAX_VOICES},  // 1=off
         {"MidiChan", WidgetType::LARGE_VALUE, 7, &midiChannel, 0, 16}  // 0=OMNI
     };
     
@@ -38,7 +40,7 @@ public:
     PageParameters(SynthConfig* cfg, Synth* syn, Renderer* rend)
         : Page(cfg, syn, rend), 
           pitchMod(false), ampMod(false), egBias(false),
-          modIntensity(0), pitchBendRange(12), midiChannel(1) {}
+          modIntensity(0), pitchBendRange(12), portamentoTime(0), unisonVoices(1), midiChannel(1) {}
     
     void enter() override {
         Page::enter();
@@ -49,6 +51,8 @@ public:
         egBias = synth->params.modWheelAssignment.egBias;
         modIntensity = synth->params.modWheelIntensity;
         pitchBendRange = synth->params.pitchBendRange;
+        portamentoTime = synth->params.portamentoTime;
+        unisonVoices = synth->params.unisonVoices;
         midiChannel = synth->params.midiChannel;
     }
     
@@ -125,6 +129,32 @@ public:
                 }
                 break;
                 
+            case 5:  // Portamento Time
+                {
+                    int16_t newValue = static_cast<int16_t>(portamentoTime) + direction;
+                    newValue = constrain(newValue, 0, 99);
+                    if (newValue != portamentoTime) {
+                        portamentoTime = static_cast<uint8_t>(newValue);
+                        synth->params.portamentoTime = portamentoTime;
+                        dirtyWidget = 5;
+                        changed = true;
+                    }
+                }
+                break;
+                
+            case 6:  // Unison Voices (from the next note)
+                {
+                    int16_t newValue = static_cast<int16_t>(unisonVoices) + direction;
+                    newValue = constrain(newValue, 1, UNISON_MAX_VOICES);
+                    if (newValue != unisonVoices) {
+                        unisonVoices = static_cast<uint8_t>(newValue);
+                        synth->params.unisonVoices = unisonVoices;
+                        dirtyWidget = 6;
+                        changed = true;
+                    }
+                }
+                break;
+                
             case 7:  // MIDI Channel (encoder 8, position 7)
                 {
                     int16_t newValue = static_cast<int16_t>(midiChannel) + direction;
@@ -31,7 +31,7 @@ public:
     }
     
     void handleEncoder(uint8_t encoder, int8_t direction) override {
-        if (!config) return;
+        if (!config || !synth) return;
         
         switch(encoder) {
             case 0:  // R1
@@ -82,6 +82,9 @@ public:
                 dirtyWidget = 7;
                 break;
         }
+
+        // Publish the edited config (applied at the next audio block)
+        synth->updateConfig(config);
     }
     
     bool handleButton(uint8_t button) override {